@@ -0,0 +1,32 @@
+// Global operator new/delete replacement that counts heap allocations.
+// Linked only into single-threaded micro-benchmarks: the shared counter would
+// skew a multi-threaded server under load.
+
+#include "bench_support.h++"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace neonsignal::bench {
+
+std::uint64_t allocations() { return g_allocations.load(std::memory_order_relaxed); }
+
+} // namespace neonsignal::bench
@@ -0,0 +1,297 @@
+#include "bench_support.h++"
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#include <unistd.h>
+
+namespace neonsignal::bench {
+
+// Overridden by alloc_counter.c++ in executables that count allocations.
+__attribute__((weak)) std::uint64_t allocations() { return 0; }
+
+std::chrono::nanoseconds thread_cpu_time() {
+  timespec ts{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+// ---------------------------------------------------------------------------
+// LatencySamples
+
+void LatencySamples::merge(const LatencySamples& other) {
+  samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+  sorted_ = false;
+}
+
+void LatencySamples::sort_() {
+  if (!sorted_) {
+    std::ranges::sort(samples_);
+    sorted_ = true;
+  }
+}
+
+std::uint64_t LatencySamples::percentile(double q) {
+  if (samples_.empty()) {
+    return 0;
+  }
+  sort_();
+  auto rank = static_cast<std::size_t>(q * static_cast<double>(samples_.size() - 1) + 0.5);
+  return samples_[std::min(rank, samples_.size() - 1)];
+}
+
+double LatencySamples::mean() const {
+  if (samples_.empty()) {
+    return 0;
+  }
+  double sum = 0;
+  for (auto ns : samples_) {
+    sum += static_cast<double>(ns);
+  }
+  return sum / static_cast<double>(samples_.size());
+}
+
+std::uint64_t LatencySamples::max() {
+  sort_();
+  return samples_.empty() ? 0 : samples_.back();
+}
+
+std::vector<std::pair<std::uint64_t, std::uint64_t>> LatencySamples::histogram() {
+  sort_();
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> buckets;
+  std::uint64_t bound = 1024; // 1 µs
+  for (auto ns : samples_) {
+    while (ns > bound) {
+      bound <<= 1;
+    }
+    if (buckets.empty() || buckets.back().first != bound) {
+      buckets.emplace_back(bound, 0);
+    }
+    ++buckets.back().second;
+  }
+  return buckets;
+}
+
+// ---------------------------------------------------------------------------
+// Report
+
+namespace {
+
+std::string json_escape(std::string_view in) {
+  std::string out;
+  out.reserve(in.size());
+  for (char c : in) {
+    switch (c) {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char buf[8];
+        std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+        out += buf;
+      } else {
+        out += c;
+      }
+    }
+  }
+  return out;
+}
+
+std::string json_number(double value) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.3f", value);
+  return buf;
+}
+
+} // namespace
+
+Report::Report(std::string suite) : suite_(std::move(suite)) {}
+
+void Report::add(std::string name, Metrics metrics) {
+  entries_.push_back({std::move(name), std::move(metrics), {}});
+}
+
+void Report::add_histogram(std::vector<std::pair<std::uint64_t, std::uint64_t>> buckets) {
+  if (!entries_.empty()) {
+    entries_.back().histogram = std::move(buckets);
+  }
+}
+
+void Report::set_param(std::string key, std::string value) {
+  params_.emplace_back(std::move(key), std::move(value));
+}
+
+bool Report::write_json(const std::filesystem::path& path) const {
+  std::ofstream out(path, std::ios::trunc);
+  if (!out) {
+    return false;
+  }
+  out << "{\n  \"suite\": \"" << json_escape(suite_) << "\",\n";
+  out << "  \"timestamp\": " << std::time(nullptr) << ",\n";
+  out << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n";
+  out << "  \"params\": {";
+  for (std::size_t i = 0; i < params_.size(); ++i) {
+    out << (i ? ", " : "") << '"' << json_escape(params_[i].first) << "\": \""
+        << json_escape(params_[i].second) << '"';
+  }
+  out << "},\n  \"results\": [";
+  for (std::size_t i = 0; i < entries_.size(); ++i) {
+    const auto& entry = entries_[i];
+    out << (i ? "," : "") << "\n    {\"name\": \"" << json_escape(entry.name) << '"';
+    for (const auto& [key, value] : entry.metrics) {
+      out << ", \"" << json_escape(key) << "\": " << json_number(value);
+    }
+    if (!entry.histogram.empty()) {
+      out << ", \"histogram_ns\": [";
+      for (std::size_t b = 0; b < entry.histogram.size(); ++b) {
+        out << (b ? ", " : "") << '[' << entry.histogram[b].first << ", "
+            << entry.histogram[b].second << ']';
+      }
+      out << ']';
+    }
+    out << '}';
+  }
+  out << "\n  ]\n}\n";
+  return static_cast<bool>(out);
+}
+
+void report_timing(Report& report, std::string_view name, const Timing& timing,
+                   Report::Metrics extra) {
+  std::printf("  %-44s %12.1f ns/op %8.2f allocs/op\n", std::string(name).c_str(),
+              timing.ns_per_op, timing.allocs_per_op);
+  Report::Metrics metrics = {{"ns_per_op", timing.ns_per_op},
+                             {"allocs_per_op", timing.allocs_per_op},
+                             {"iterations", static_cast<double>(timing.iterations)}};
+  for (auto& metric : extra) {
+    std::printf("    ↳ %s: %.1f\n", metric.first.c_str(), metric.second);
+    metrics.push_back(std::move(metric));
+  }
+  report.add(std::string(name), std::move(metrics));
+}
+
+// ---------------------------------------------------------------------------
+// Fixtures
+
+ScratchDir::ScratchDir(std::string_view prefix) {
+  std::string pattern =
+      (std::filesystem::temp_directory_path() / (std::string(prefix) + "-XXXXXX")).string();
+  if (!mkdtemp(pattern.data())) {
+    throw std::runtime_error("mkdtemp failed for " + pattern);
+  }
+  path_ = pattern;
+}
+
+ScratchDir::~ScratchDir() {
+  std::error_code ec;
+  std::filesystem::remove_all(path_, ec);
+}
+
+void write_file(const std::filesystem::path& path, std::string_view content) {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+
+std::string filler_text(std::size_t size, std::uint32_t seed) {
+  static constexpr std::string_view kWords[] = {
+      "neon ", "signal ", "stream ", "frame ", "header ", "window ", "<div> ", "</div>\n",
+      "const ", "return ", "function ", "{ ", "} ", "0x7f ", "cache ", "flow "};
+  std::mt19937 rng(seed);
+  std::string out;
+  out.reserve(size + 16);
+  while (out.size() < size) {
+    out += kWords[rng() % std::size(kWords)];
+  }
+  out.resize(size);
+  return out;
+}
+
+bool write_self_signed_cert(const std::filesystem::path& dir, std::string_view common_name,
+                            const std::vector<std::string>& subject_alt_names) {
+  std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> key(EVP_EC_gen("P-256"), EVP_PKEY_free);
+  std::unique_ptr<X509, decltype(&X509_free)> cert(X509_new(), X509_free);
+  if (!key || !cert) {
+    return false;
+  }
+
+  X509_set_version(cert.get(), 2);
+  ASN1_INTEGER_set(X509_get_serialNumber(cert.get()), static_cast<long>(std::random_device{}()));
+  X509_gmtime_adj(X509_getm_notBefore(cert.get()), -60);
+  X509_gmtime_adj(X509_getm_notAfter(cert.get()), 60L * 60 * 24 * 365);
+  X509_set_pubkey(cert.get(), key.get());
+
+  X509_NAME* name = X509_get_subject_name(cert.get());
+  std::string cn(common_name);
+  X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_UTF8,
+                             reinterpret_cast<const unsigned char*>(cn.c_str()), -1, -1, 0);
+  X509_set_issuer_name(cert.get(), name);
+
+  if (!subject_alt_names.empty()) {
+    std::string san;
+    for (const auto& entry : subject_alt_names) {
+      san += (san.empty() ? "" : ",") + entry;
+    }
+    X509V3_CTX ctx;
+    X509V3_set_ctx_nodb(&ctx);
+    X509V3_set_ctx(&ctx, cert.get(), cert.get(), nullptr, nullptr, 0);
+    X509_EXTENSION* ext = X509V3_EXT_conf_nid(nullptr, &ctx, NID_subject_alt_name, san.c_str());
+    if (!ext) {
+      return false;
+    }
+    X509_add_ext(cert.get(), ext, -1);
+    X509_EXTENSION_free(ext);
+  }
+
+  if (X509_sign(cert.get(), key.get(), EVP_sha256()) == 0) {
+    return false;
+  }
+
+  std::filesystem::create_directories(dir);
+  auto write_pem = [](const std::filesystem::path& path, auto&& writer) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+      return false;
+    }
+    bool ok = writer(f) == 1;
+    std::fclose(f);
+    return ok;
+  };
+  return write_pem(dir / "fullchain.pem",
+                   [&](FILE* f) { return PEM_write_X509(f, cert.get()); }) &&
+         write_pem(dir / "privkey.pem", [&](FILE* f) {
+           return PEM_write_PrivateKey(f, key.get(), nullptr, nullptr, 0, nullptr, nullptr);
+         });
+}
+
+std::string arg_value(int argc, char* argv[], std::string_view name,
+                      std::string_view fallback) {
+  std::string prefix = "--" + std::string(name) + "=";
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg.starts_with(prefix)) {
+      return std::string(arg.substr(prefix.size()));
+    }
+  }
+  return std::string(fallback);
+}
+
+} // namespace neonsignal::bench
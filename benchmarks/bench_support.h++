@@ -0,0 +1,142 @@
+#pragma once
+
+// Shared pieces of the benchmark executables: timing loops, latency
+// percentiles, JSON reports and on-disk fixtures (scratch directories and
+// self-signed certificates).
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace neonsignal::bench {
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps a computed value alive so the optimizer cannot drop the work.
+template <typename T> inline void keep(const T& value) {
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+// Heap allocations since start-up; zero unless alloc_counter.c++ is linked in.
+std::uint64_t allocations();
+
+struct Timing {
+  double ns_per_op{0};
+  double allocs_per_op{0};
+  std::uint64_t iterations{0};
+};
+
+// Run `fn(i)` for `iterations` rounds after a short warm-up.
+template <typename Fn> Timing measure(std::uint64_t iterations, Fn&& fn) {
+  for (std::uint64_t i = 0; i < iterations / 10 + 1; ++i) {
+    fn(i);
+  }
+  auto allocs_before = allocations();
+  auto start = Clock::now();
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    fn(i);
+  }
+  auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+  auto allocs = allocations() - allocs_before;
+  return {elapsed / static_cast<double>(iterations),
+          static_cast<double>(allocs) / static_cast<double>(iterations), iterations};
+}
+
+// CPU time consumed by the calling thread.
+std::chrono::nanoseconds thread_cpu_time();
+
+/**
+ * Raw latency samples (nanoseconds). Samples are kept rather than bucketed so
+ * percentiles are exact; a run of a few million requests is a few MiB.
+ */
+class LatencySamples {
+public:
+  void record(std::uint64_t ns) { samples_.push_back(ns); }
+  void merge(const LatencySamples& other);
+
+  [[nodiscard]] std::size_t count() const { return samples_.size(); }
+  // q in [0, 1]; sorts lazily.
+  [[nodiscard]] std::uint64_t percentile(double q);
+  [[nodiscard]] double mean() const;
+  [[nodiscard]] std::uint64_t max();
+  // Counts per power-of-two bucket: {upper bound in ns, count}.
+  [[nodiscard]] std::vector<std::pair<std::uint64_t, std::uint64_t>> histogram();
+
+private:
+  void sort_();
+
+  std::vector<std::uint64_t> samples_;
+  bool sorted_{true};
+};
+
+/**
+ * Named results of one benchmark run, printed as they arrive and written as a
+ * single JSON document so runs can be diffed.
+ */
+class Report {
+public:
+  using Metrics = std::vector<std::pair<std::string, double>>;
+
+  explicit Report(std::string suite);
+
+  void add(std::string name, Metrics metrics);
+  // Attach a latency histogram to the most recently added result.
+  void add_histogram(std::vector<std::pair<std::uint64_t, std::uint64_t>> buckets);
+  // Free-form run parameters (duration, connection count, ...).
+  void set_param(std::string key, std::string value);
+
+  [[nodiscard]] bool write_json(const std::filesystem::path& path) const;
+
+private:
+  struct Entry {
+    std::string name;
+    Metrics metrics;
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> histogram;
+  };
+
+  std::string suite_;
+  std::vector<std::pair<std::string, std::string>> params_;
+  std::vector<Entry> entries_;
+};
+
+// Print a micro-benchmark line and add it to `report`.
+void report_timing(Report& report, std::string_view name, const Timing& timing,
+                   Report::Metrics extra = {});
+
+// mkdtemp()-backed scratch directory, removed recursively on destruction.
+class ScratchDir {
+public:
+  explicit ScratchDir(std::string_view prefix);
+  ~ScratchDir();
+
+  ScratchDir(const ScratchDir&) = delete;
+  ScratchDir& operator=(const ScratchDir&) = delete;
+
+  [[nodiscard]] const std::filesystem::path& path() const { return path_; }
+
+private:
+  std::filesystem::path path_;
+};
+
+void write_file(const std::filesystem::path& path, std::string_view content);
+// Deterministic, mildly compressible text of `size` bytes.
+std::string filler_text(std::size_t size, std::uint32_t seed = 1);
+
+/**
+ * Write `dir/fullchain.pem` and `dir/privkey.pem`: a P-256 self-signed
+ * certificate for `common_name` with the given DNS/IP subjectAltNames
+ * (e.g. "DNS:localhost", "IP:127.0.0.1"), the layout CertManager scans for.
+ */
+bool write_self_signed_cert(const std::filesystem::path& dir, std::string_view common_name,
+                            const std::vector<std::string>& subject_alt_names);
+
+// Value of "--name=value" in argv, or `fallback`.
+std::string arg_value(int argc, char* argv[], std::string_view name,
+                      std::string_view fallback = {});
+
+} // namespace neonsignal::bench
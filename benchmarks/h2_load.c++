@@ -0,0 +1,681 @@
+// Loopback HTTP/2 load generator (nghttp2 client sessions over OpenSSL).
+//
+//   h2_load [--scenario=<name>] [--duration=<seconds>] [--connections=<n>]
+//           [--json=<path>] [--target=<host:port>] [--server-log=<path>]
+//
+// Without --target it writes a scratch www root, a self-signed _default
+// certificate and a fresh database, starts Server on 127.0.0.1 in-process and
+// drives it; server logging goes to --server-log (default /dev/null).
+//
+// Scenarios:
+//   small_static  8 streams in flight per connection, 1 KiB asset
+//   large_file    1 stream per connection, 8 MiB file streamed from disk
+//   many_streams  2 connections, 100 streams in flight each, 1 KiB asset
+//   sse_fanout    200 /api/events subscribers plus one connection of static
+//                 traffic; latency is each delivery's lag behind the first
+//                 subscriber that received the same event
+//   tls_full      new connection per round: connect + full TLS handshake
+//   tls_resumed   as tls_full, offering the previous connection's session
+//                 ticket; reports how many handshakes actually resumed
+//
+// Set NEONSIGNAL_KTLS=1 to run the in-process server with kernel TLS, so
+// large_file shows the SSL_sendfile() path (needs the tls kernel module).
+
+#include "bench_support.h++"
+
+#include "spin/database.h++"
+#include "spin/neonsignal.h++"
+
+#include <nghttp2/nghttp2.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+using namespace neonsignal;
+using namespace std::chrono_literals;
+using bench::Clock;
+
+constexpr std::uint16_t kDefaultPort = 19443;
+constexpr std::size_t kSmallBytes = 1024;
+constexpr std::size_t kLargeBytes = 8 * 1024 * 1024;
+constexpr std::int32_t kClientWindow = 16 * 1024 * 1024;
+
+// nghttp2 1.60 replaced the ssize_t callback/receive API with nghttp2_ssize.
+#if NGHTTP2_VERSION_NUM >= 0x013c00
+using SendResult = nghttp2_ssize;
+#define NS_SET_SEND_CALLBACK nghttp2_session_callbacks_set_send_callback2
+#define NS_SESSION_MEM_RECV nghttp2_session_mem_recv2
+#else
+using SendResult = ssize_t;
+#define NS_SET_SEND_CALLBACK nghttp2_session_callbacks_set_send_callback
+#define NS_SESSION_MEM_RECV nghttp2_session_mem_recv
+#endif
+
+struct Target {
+  std::string host{"127.0.0.1"};
+  std::uint16_t port{kDefaultPort};
+  std::string session_cookie; // ns_session value for protected routes
+};
+
+struct Workload {
+  std::string path;
+  std::size_t streams{1}; // in flight per connection
+  bool sse{false};        // streams stay open until the deadline
+};
+
+// What one connection observed.
+struct ConnectionStats {
+  bench::LatencySamples latency;
+  std::uint64_t responses{0};
+  std::uint64_t errors{0};
+  std::uint64_t body_bytes{0};
+  // SSE: (payload, arrival) per received event, first event per stream skipped
+  std::vector<std::pair<std::string, Clock::time_point>> events;
+};
+
+int connect_tcp(const Target& target) {
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* res = nullptr;
+  auto port = std::to_string(target.port);
+  if (getaddrinfo(target.host.c_str(), port.c_str(), &hints, &res) != 0) {
+    return -1;
+  }
+  int fd = -1;
+  for (auto* ai = res; ai; ai = ai->ai_next) {
+    fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+    if (fd == -1) {
+      continue;
+    }
+    if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+      break;
+    }
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(res);
+  if (fd != -1) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    // Bounded reads let SSE clients notice the deadline between events.
+    timeval tv{0, 200'000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  }
+  return fd;
+}
+
+SSL_CTX* client_ctx() {
+  static SSL_CTX* ctx = [] {
+    SSL_CTX* c = SSL_CTX_new(TLS_client_method());
+    SSL_CTX_set_min_proto_version(c, TLS1_2_VERSION);
+    SSL_CTX_set_verify(c, SSL_VERIFY_NONE, nullptr);
+    static const unsigned char alpn[] = {0x02, 'h', '2'};
+    SSL_CTX_set_alpn_protos(c, alpn, sizeof(alpn));
+    return c;
+  }();
+  return ctx;
+}
+
+/**
+ * One blocking client connection on its own thread. Keeps `streams` requests
+ * in flight until the deadline, then drains them.
+ */
+class Connection {
+public:
+  Connection(const Target& target, const Workload& work, Clock::time_point deadline)
+      : target_(target), work_(work), deadline_(deadline) {}
+
+  ~Connection() {
+    if (session_) {
+      nghttp2_session_del(session_);
+    }
+    if (ssl_) {
+      SSL_free(ssl_);
+    }
+    if (fd_ != -1) {
+      close(fd_);
+    }
+  }
+
+  Connection(const Connection&) = delete;
+  Connection& operator=(const Connection&) = delete;
+
+  bool run() {
+    if (!open_()) {
+      ++stats.errors;
+      return false;
+    }
+    authority_ = target_.host + ":" + std::to_string(target_.port);
+    std::vector<std::uint8_t> buf(64 * 1024);
+    while (true) {
+      bool accepting = Clock::now() < deadline_;
+      while (accepting && inflight_.size() < work_.streams) {
+        if (!submit_()) {
+          return false;
+        }
+      }
+      if (!accepting && (inflight_.empty() || work_.sse)) {
+        break;
+      }
+      if (nghttp2_session_send(session_) != 0) {
+        ++stats.errors;
+        return false;
+      }
+      int n = SSL_read(ssl_, buf.data(), static_cast<int>(buf.size()));
+      if (n <= 0) {
+        int err = SSL_get_error(ssl_, n);
+        if (err == SSL_ERROR_WANT_READ || (err == SSL_ERROR_SYSCALL && errno == EAGAIN)) {
+          ERR_clear_error();
+          continue; // read timeout; re-check the deadline
+        }
+        stats.errors += inflight_.size();
+        return false;
+      }
+      if (NS_SESSION_MEM_RECV(session_, buf.data(), static_cast<std::size_t>(n)) < 0) {
+        ++stats.errors;
+        return false;
+      }
+    }
+    nghttp2_session_terminate_session(session_, NGHTTP2_NO_ERROR);
+    nghttp2_session_send(session_);
+    return true;
+  }
+
+  ConnectionStats stats;
+
+private:
+  struct InFlight {
+    Clock::time_point started;
+    int status{0};
+    bool first_event_seen{false};
+  };
+
+  bool open_() {
+    fd_ = connect_tcp(target_);
+    if (fd_ == -1) {
+      return false;
+    }
+    ssl_ = SSL_new(client_ctx());
+    SSL_set_fd(ssl_, fd_);
+    SSL_set_tlsext_host_name(ssl_, "localhost");
+    if (SSL_connect(ssl_) != 1) {
+      return false;
+    }
+    const unsigned char* proto = nullptr;
+    unsigned int proto_len = 0;
+    SSL_get0_alpn_selected(ssl_, &proto, &proto_len);
+    if (proto_len != 2 || std::memcmp(proto, "h2", 2) != 0) {
+      return false;
+    }
+
+    nghttp2_session_callbacks* callbacks = nullptr;
+    nghttp2_session_callbacks_new(&callbacks);
+    NS_SET_SEND_CALLBACK(callbacks, &Connection::on_send_);
+    nghttp2_session_callbacks_set_on_header_callback(callbacks, &Connection::on_header_);
+    nghttp2_session_callbacks_set_on_data_chunk_recv_callback(callbacks, &Connection::on_data_);
+    nghttp2_session_callbacks_set_on_stream_close_callback(callbacks,
+                                                           &Connection::on_stream_close_);
+    nghttp2_session_client_new(&session_, callbacks, this);
+    nghttp2_session_callbacks_del(callbacks);
+
+    nghttp2_settings_entry settings[] = {
+        {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, 100},
+        {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE, static_cast<std::uint32_t>(kClientWindow)}};
+    nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, settings, std::size(settings));
+    nghttp2_session_set_local_window_size(session_, NGHTTP2_FLAG_NONE, 0, kClientWindow);
+    return true;
+  }
+
+  bool submit_() {
+    auto nv = [](std::string_view name, std::string_view value) {
+      return nghttp2_nv{reinterpret_cast<std::uint8_t*>(const_cast<char*>(name.data())),
+                        reinterpret_cast<std::uint8_t*>(const_cast<char*>(value.data())),
+                        name.size(), value.size(), NGHTTP2_NV_FLAG_NONE};
+    };
+    std::vector<nghttp2_nv> headers = {nv(":method", "GET"), nv(":scheme", "https"),
+                                       nv(":authority", authority_), nv(":path", work_.path),
+                                       nv("user-agent", "neonsignal-h2_load")};
+    std::string cookie;
+    if (!target_.session_cookie.empty()) {
+      cookie = "ns_session=" + target_.session_cookie;
+      headers.push_back(nv("cookie", cookie));
+    }
+    auto stream_id =
+        nghttp2_submit_request(session_, nullptr, headers.data(), headers.size(), nullptr, this);
+    if (stream_id < 0) {
+      ++stats.errors;
+      return false;
+    }
+    inflight_[stream_id] = {Clock::now(), 0, false};
+    return true;
+  }
+
+  static SendResult on_send_(nghttp2_session*, const std::uint8_t* data, std::size_t length,
+                                int, void* user_data) {
+    auto* self = static_cast<Connection*>(user_data);
+    std::size_t sent = 0;
+    while (sent < length) {
+      int n = SSL_write(self->ssl_, data + sent, static_cast<int>(length - sent));
+      if (n <= 0) {
+        return NGHTTP2_ERR_CALLBACK_FAILURE;
+      }
+      sent += static_cast<std::size_t>(n);
+    }
+    return static_cast<SendResult>(length);
+  }
+
+  static int on_header_(nghttp2_session*, const nghttp2_frame* frame, const std::uint8_t* name,
+                        std::size_t namelen, const std::uint8_t* value, std::size_t valuelen,
+                        std::uint8_t, void* user_data) {
+    auto* self = static_cast<Connection*>(user_data);
+    if (namelen == 7 && std::memcmp(name, ":status", 7) == 0) {
+      if (auto it = self->inflight_.find(frame->hd.stream_id); it != self->inflight_.end()) {
+        it->second.status = std::atoi(std::string(reinterpret_cast<const char*>(value),
+                                                  valuelen).c_str());
+      }
+    }
+    return 0;
+  }
+
+  static int on_data_(nghttp2_session*, std::uint8_t, std::int32_t stream_id,
+                      const std::uint8_t* data, std::size_t len, void* user_data) {
+    auto* self = static_cast<Connection*>(user_data);
+    self->stats.body_bytes += len;
+    if (self->work_.sse) {
+      auto now = Clock::now();
+      auto it = self->inflight_.find(stream_id);
+      if (it == self->inflight_.end()) {
+        return 0;
+      }
+      // The first event replays the channel's last payload on subscribe.
+      if (!it->second.first_event_seen) {
+        it->second.first_event_seen = true;
+        return 0;
+      }
+      self->stats.events.emplace_back(std::string(reinterpret_cast<const char*>(data), len), now);
+    }
+    return 0;
+  }
+
+  static int on_stream_close_(nghttp2_session*, std::int32_t stream_id, std::uint32_t error_code,
+                              void* user_data) {
+    auto* self = static_cast<Connection*>(user_data);
+    auto it = self->inflight_.find(stream_id);
+    if (it == self->inflight_.end()) {
+      return 0;
+    }
+    if (error_code != NGHTTP2_NO_ERROR || it->second.status != 200) {
+      ++self->stats.errors;
+    } else {
+      ++self->stats.responses;
+      self->stats.latency.record(static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - it->second.started)
+              .count()));
+    }
+    self->inflight_.erase(it);
+    return 0;
+  }
+
+  const Target& target_;
+  const Workload& work_;
+  Clock::time_point deadline_;
+  std::string authority_;
+  int fd_{-1};
+  SSL* ssl_{nullptr};
+  nghttp2_session* session_{nullptr};
+  std::unordered_map<std::int32_t, InFlight> inflight_;
+};
+
+// Run `connections` clients of `work` in parallel and merge what they saw.
+ConnectionStats drive(const Target& target, const Workload& work, std::size_t connections,
+                      std::chrono::seconds duration, double& elapsed_s) {
+  ConnectionStats total;
+  std::mutex mutex;
+  std::vector<std::thread> threads;
+  auto start = Clock::now();
+  auto deadline = start + duration;
+  for (std::size_t i = 0; i < connections; ++i) {
+    threads.emplace_back([&] {
+      Connection conn(target, work, deadline);
+      conn.run();
+      std::lock_guard lock(mutex);
+      total.latency.merge(conn.stats.latency);
+      total.responses += conn.stats.responses;
+      total.errors += conn.stats.errors;
+      total.body_bytes += conn.stats.body_bytes;
+      total.events.insert(total.events.end(), conn.stats.events.begin(), conn.stats.events.end());
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+  return total;
+}
+
+void report_latency(bench::Report& report, const std::string& name, ConnectionStats& stats,
+                    double elapsed_s, double units, const char* unit_name) {
+  auto& lat = stats.latency;
+  auto us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+  double rate = units / elapsed_s;
+  double mib_s = static_cast<double>(stats.body_bytes) / (1024.0 * 1024.0) / elapsed_s;
+  std::printf("  %-14s %10.0f %s/s %9.1f MiB/s  p50 %8.1f µs  p99 %8.1f µs  p999 %8.1f µs"
+              "  errors %llu\n",
+              name.c_str(), rate, unit_name, mib_s, us(lat.percentile(0.50)),
+              us(lat.percentile(0.99)), us(lat.percentile(0.999)),
+              static_cast<unsigned long long>(stats.errors));
+  report.add(name, {{std::string(unit_name) + "_per_s", rate},
+                    {"MiB_per_s", mib_s},
+                    {"samples", static_cast<double>(lat.count())},
+                    {"errors", static_cast<double>(stats.errors)},
+                    {"mean_us", lat.mean() / 1000.0},
+                    {"p50_us", us(lat.percentile(0.50))},
+                    {"p99_us", us(lat.percentile(0.99))},
+                    {"p999_us", us(lat.percentile(0.999))},
+                    {"max_us", us(lat.max())}});
+  report.add_histogram(lat.histogram());
+}
+
+void run_request_scenario(bench::Report& report, const Target& target, const std::string& name,
+                          const Workload& work, std::size_t connections,
+                          std::chrono::seconds duration) {
+  double elapsed_s = 0;
+  auto stats = drive(target, work, connections, duration, elapsed_s);
+  report_latency(report, name, stats, elapsed_s, static_cast<double>(stats.responses), "req");
+}
+
+void run_sse_scenario(bench::Report& report, const Target& target, std::size_t subscribers,
+                      std::chrono::seconds duration) {
+  constexpr std::size_t kStreamsPerConnection = 50;
+  Workload sse{"/api/events", kStreamsPerConnection, true};
+  Workload traffic{"/assets/small.js", 4, false};
+
+  double elapsed_s = 0;
+  std::thread driver([&] {
+    double ignored = 0;
+    drive(target, traffic, 1, duration, ignored);
+  });
+  auto stats = drive(target, sse, (subscribers + kStreamsPerConnection - 1) / kStreamsPerConnection,
+                     duration, elapsed_s);
+  driver.join();
+
+  // Lag of every delivery behind the earliest delivery of the same event;
+  // samples from streams the server ended (reset policy) are not event lags.
+  stats.latency = {};
+  std::unordered_map<std::string_view, Clock::time_point> first_seen;
+  for (const auto& [payload, at] : stats.events) {
+    auto [it, inserted] = first_seen.emplace(payload, at);
+    if (!inserted && at < it->second) {
+      it->second = at;
+    }
+  }
+  for (const auto& [payload, at] : stats.events) {
+    stats.latency.record(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(at - first_seen[payload]).count()));
+  }
+  report_latency(report, "sse_fanout", stats, elapsed_s, static_cast<double>(stats.events.size()),
+                 "event");
+  std::printf("    ↳ %zu distinct events to %zu subscribers\n", first_seen.size(), subscribers);
+}
+
+/**
+ * Handshake rate: each round connects, completes TLS, reads the server's
+ * first flight (which carries the session ticket) and resets the
+ * connection. With `resume`, every round offers the previous round's session.
+ */
+void run_handshake_scenario(bench::Report& report, const Target& target, const std::string& name,
+                            bool resume, std::size_t connections, std::chrono::seconds duration) {
+  ConnectionStats total;
+  std::uint64_t resumed = 0;
+  std::mutex mutex;
+  std::vector<std::thread> threads;
+  auto start = Clock::now();
+  auto deadline = start + duration;
+  for (std::size_t i = 0; i < connections; ++i) {
+    threads.emplace_back([&] {
+      ConnectionStats stats;
+      std::uint64_t reused = 0;
+      SSL_SESSION* session = nullptr;
+      std::vector<std::uint8_t> buf(16 * 1024);
+      while (Clock::now() < deadline) {
+        auto begin = Clock::now();
+        int fd = connect_tcp(target);
+        if (fd == -1) {
+          ++stats.errors;
+          continue;
+        }
+        SSL* ssl = SSL_new(client_ctx());
+        SSL_set_fd(ssl, fd);
+        SSL_set_tlsext_host_name(ssl, "localhost");
+        if (resume && session) {
+          SSL_set_session(ssl, session);
+        }
+        if (SSL_connect(ssl) == 1) {
+          stats.latency.record(static_cast<std::uint64_t>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin)
+                  .count()));
+          ++stats.responses;
+          reused += SSL_session_reused(ssl) == 1 ? 1 : 0;
+          SSL_read(ssl, buf.data(), static_cast<int>(buf.size()));
+          if (SSL_SESSION* next = resume ? SSL_get1_session(ssl) : nullptr) {
+            SSL_SESSION_free(session);
+            session = next;
+          }
+          // Freed without close_notify, OpenSSL would mark the session unresumable.
+          SSL_shutdown(ssl);
+        } else {
+          ++stats.errors;
+        }
+        ERR_clear_error();
+        SSL_free(ssl);
+        // RST instead of FIN keeps thousands of closes/s out of TIME_WAIT.
+        linger reset{1, 0};
+        setsockopt(fd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+        close(fd);
+      }
+      SSL_SESSION_free(session);
+      std::lock_guard lock(mutex);
+      total.latency.merge(stats.latency);
+      total.responses += stats.responses;
+      total.errors += stats.errors;
+      resumed += reused;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+  report_latency(report, name, total, elapsed_s, static_cast<double>(total.responses), "hs");
+  std::printf("    ↳ %llu of %llu handshakes resumed\n", static_cast<unsigned long long>(resumed),
+              static_cast<unsigned long long>(total.responses));
+  report.add(name + "_resumption",
+             {{"resumed", static_cast<double>(resumed)},
+              {"ratio", total.responses ? static_cast<double>(resumed) /
+                                              static_cast<double>(total.responses)
+                                        : 0.0}});
+}
+
+bool wait_for_port(const Target& target, std::chrono::seconds timeout) {
+  auto deadline = Clock::now() + timeout;
+  while (Clock::now() < deadline) {
+    int fd = connect_tcp(target);
+    if (fd != -1) {
+      close(fd);
+      return true;
+    }
+    std::this_thread::sleep_for(50ms);
+  }
+  return false;
+}
+
+/**
+ * Scratch www root, certificate and database for an in-process Server.
+ */
+struct Fixture {
+  bench::ScratchDir root{"neonsignal-h2load"};
+  ServerConfig config;
+  std::string session_cookie;
+
+  bool prepare(std::uint16_t port) {
+    auto www = root.path() / "www";
+    bench::write_file(www / "index.html", "<!doctype html><title>h2_load</title>");
+    bench::write_file(www / "assets" / "small.js", bench::filler_text(kSmallBytes));
+    bench::write_file(www / "assets" / "large.bin", bench::filler_text(kLargeBytes, 7));
+    if (!bench::write_self_signed_cert(root.path() / "certs" / "_default", "localhost",
+                                       {"DNS:localhost", "IP:127.0.0.1"})) {
+      return false;
+    }
+
+    config.host = "127.0.0.1";
+    config.port = port;
+    config.www_root = www.string();
+    config.certs_root = (root.path() / "certs").string();
+    config.db_path = (root.path() / "data" / "neonsignal.mdb").string();
+    config.working_dir = root.path().string();
+
+    // SSE routes require a session; seed one before the server opens the file.
+    Database db(config.db_path);
+    session_cookie = db.create_session(1, "h2_load", "authenticated", std::chrono::hours(1));
+    return !session_cookie.empty();
+  }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  auto scenario = bench::arg_value(argc, argv, "scenario");
+  auto json = bench::arg_value(argc, argv, "json");
+  auto target_arg = bench::arg_value(argc, argv, "target");
+  auto server_log = bench::arg_value(argc, argv, "server-log", "/dev/null");
+  auto duration = std::chrono::seconds(std::stoul(bench::arg_value(argc, argv, "duration", "10")));
+  auto connections = std::stoul(bench::arg_value(argc, argv, "connections", "8"));
+
+  // Route SIGTERM/SIGINT to the server's signalfd: every thread inherits the mask.
+  sigset_t mask;
+  sigemptyset(&mask);
+  sigaddset(&mask, SIGINT);
+  sigaddset(&mask, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+  std::signal(SIGPIPE, SIG_IGN);
+
+  Target target;
+  std::unique_ptr<Fixture> fixture;
+  std::unique_ptr<Server> server;
+  std::thread server_thread;
+  std::atomic<bool> server_failed{false};
+
+  if (!target_arg.empty()) {
+    auto colon = target_arg.rfind(':');
+    target.host = target_arg.substr(0, colon);
+    if (colon != std::string::npos) {
+      target.port = static_cast<std::uint16_t>(std::stoul(target_arg.substr(colon + 1)));
+    }
+    target.session_cookie = bench::arg_value(argc, argv, "session");
+  } else {
+    fixture = std::make_unique<Fixture>();
+    if (!fixture->prepare(target.port)) {
+      std::fprintf(stderr, "✗ could not prepare server fixture\n");
+      return 1;
+    }
+    target.session_cookie = fixture->session_cookie;
+    for (const char* name : {"NEONSIGNAL_HOST", "NEONSIGNAL_PORT", "NEONSIGNAL_WWW_ROOT",
+                             "NEONSIGNAL_CERTS_ROOT", "NEONSIGNAL_DB_PATH"}) {
+      unsetenv(name);
+    }
+
+    int log_fd = open(server_log.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (log_fd != -1) {
+      dup2(log_fd, STDERR_FILENO);
+      close(log_fd);
+    }
+
+    server = std::make_unique<Server>(fixture->config);
+    server_thread = std::thread([&] {
+      try {
+        server->run();
+      } catch (const std::exception& e) {
+        std::printf("✗ server: %s\n", e.what());
+        server_failed = true;
+      }
+    });
+    if (!wait_for_port(target, 10s) || server_failed) {
+      std::printf("✗ server did not start on %s:%u\n", target.host.c_str(), target.port);
+      if (server_thread.joinable()) {
+        pthread_kill(server_thread.native_handle(), SIGTERM);
+        server_thread.join();
+      }
+      return 1;
+    }
+  }
+
+  bench::Report report("h2_load");
+  report.set_param("duration_s", std::to_string(duration.count()));
+  report.set_param("connections", std::to_string(connections));
+  report.set_param("target", target.host + ":" + std::to_string(target.port));
+  std::printf("• h2_load against %s:%u, %lds per scenario\n", target.host.c_str(), target.port,
+              static_cast<long>(duration.count()));
+
+  auto wanted = [&](std::string_view name) { return scenario.empty() || scenario == name; };
+  if (wanted("small_static")) {
+    run_request_scenario(report, target, "small_static", {"/assets/small.js", 8, false},
+                         connections, duration);
+  }
+  if (wanted("large_file")) {
+    run_request_scenario(report, target, "large_file", {"/assets/large.bin", 1, false},
+                         connections, duration);
+  }
+  if (wanted("many_streams")) {
+    run_request_scenario(report, target, "many_streams", {"/assets/small.js", 100, false}, 2,
+                         duration);
+  }
+  if (wanted("sse_fanout")) {
+    run_sse_scenario(report, target, 200, duration);
+  }
+  if (wanted("tls_full")) {
+    run_handshake_scenario(report, target, "tls_full", false, connections, duration);
+  }
+  if (wanted("tls_resumed")) {
+    run_handshake_scenario(report, target, "tls_resumed", true, connections, duration);
+  }
+
+  if (server_thread.joinable()) {
+    pthread_kill(server_thread.native_handle(), SIGTERM);
+    server_thread.join();
+  }
+
+  if (!json.empty()) {
+    if (!report.write_json(json)) {
+      std::printf("✗ could not write %s\n", json.c_str());
+      return 1;
+    }
+    std::printf("✓ results written to %s\n", json.c_str());
+  }
+  return 0;
+}
@@ -0,0 +1,247 @@
+// HPACK micro-benchmark: request decode (map vs HeaderView) and response
+// encode (stateless literals vs the per-connection HpackEncoder).
+//
+// Reports time, heap allocations and header block bytes per request, measured
+// over a simulated long-lived connection repeating a browser-like request mix.
+
+#include "spin/header_view.h++"
+#include "spin/hpack_decoder.h++"
+#include "spin/hpack_encoder.h++"
+#include "spin/http2_listener_helpers.h++"
+
+#include <nghttp2/nghttp2.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+using namespace neonsignal;
+using Clock = std::chrono::steady_clock;
+using Headers = std::vector<std::pair<std::string, std::string>>;
+
+constexpr int kIterations = 100'000;
+
+struct Result {
+  double ns_per_op{0};
+  double allocs_per_op{0};
+  double bytes_per_op{0};
+};
+
+template <typename Fn> Result measure(int iterations, Fn&& fn) {
+  std::size_t bytes = 0;
+  auto allocs_before = g_allocations.load(std::memory_order_relaxed);
+  auto start = Clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    bytes += fn(i);
+  }
+  auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+  auto allocs = g_allocations.load(std::memory_order_relaxed) - allocs_before;
+  return {elapsed / iterations, static_cast<double>(allocs) / iterations,
+          static_cast<double>(bytes) / iterations};
+}
+
+void report(const char* name, const Result& r) {
+  std::printf("  %-34s %10.1f ns/op %8.2f allocs/op %8.1f bytes/op\n", name, r.ns_per_op,
+              r.allocs_per_op, r.bytes_per_op);
+}
+
+nghttp2_nv nv(const std::string& name, const std::string& value) {
+  return {reinterpret_cast<std::uint8_t*>(const_cast<char*>(name.data())),
+          reinterpret_cast<std::uint8_t*>(const_cast<char*>(value.data())), name.size(),
+          value.size(), NGHTTP2_NV_FLAG_NONE};
+}
+
+// Request blocks as a browser would send them on one connection.
+std::vector<std::vector<std::uint8_t>> make_request_blocks(int count) {
+  const std::vector<std::string> paths = {"/", "/app.js", "/style.css", "/api/stats",
+                                          "/img/logo.svg", "/api/codex/list"};
+  Headers common = {
+      {":method", "GET"},
+      {":scheme", "https"},
+      {":authority", "neonsignal.example.com"},
+      {"user-agent", "Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0"},
+      {"accept", "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8"},
+      {"accept-language", "en-US,en;q=0.5"},
+      {"accept-encoding", "gzip, deflate, br, zstd"},
+      {"cookie", "ns_session=6f1c0e2b9a7d4c3e8f5a1b2c3d4e5f60"},
+      {"cookie", "ns_debug=1"},
+      {"if-none-match", "\"5d8c-18f3a2b4c10\""},
+  };
+
+  nghttp2_hd_deflater* deflater = nullptr;
+  nghttp2_hd_deflate_new(&deflater, 4096);
+  std::vector<std::vector<std::uint8_t>> blocks;
+  for (int i = 0; i < count; ++i) {
+    std::string path_name = ":path";
+    std::vector<nghttp2_nv> nva;
+    nva.push_back(nv(common[0].first, common[0].second));
+    nva.push_back(nv(path_name, paths[static_cast<std::size_t>(i) % paths.size()]));
+    for (std::size_t h = 1; h < common.size(); ++h) {
+      nva.push_back(nv(common[h].first, common[h].second));
+    }
+    auto bound = nghttp2_hd_deflate_bound(deflater, nva.data(), nva.size());
+    std::vector<std::uint8_t> block(bound);
+    auto rv = nghttp2_hd_deflate_hd(deflater, block.data(), bound, nva.data(), nva.size());
+    block.resize(rv < 0 ? 0 : static_cast<std::size_t>(rv));
+    blocks.push_back(std::move(block));
+  }
+  nghttp2_hd_deflate_del(deflater);
+  return blocks;
+}
+
+// The decoder as it was before HeaderView: owned strings in a map.
+struct LegacyParsed {
+  std::string method, path, authority, scheme;
+  std::unordered_map<std::string, std::string> headers;
+};
+
+std::optional<LegacyParsed> legacy_decode(nghttp2_hd_inflater* inflater,
+                                          const std::vector<std::uint8_t>& block) {
+  LegacyParsed out;
+  std::size_t off = 0;
+  while (off < block.size()) {
+    nghttp2_nv out_nv{};
+    int flags = 0;
+    auto rv = nghttp2_hd_inflate_hd2(inflater, &out_nv, &flags, block.data() + off,
+                                     block.size() - off, 1);
+    if (rv < 0) {
+      return std::nullopt;
+    }
+    off += static_cast<std::size_t>(rv);
+    if (flags & NGHTTP2_HD_INFLATE_EMIT) {
+      std::string name(reinterpret_cast<const char*>(out_nv.name), out_nv.namelen);
+      std::string value(reinterpret_cast<const char*>(out_nv.value), out_nv.valuelen);
+      std::ranges::transform(name, name.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+      });
+      if (name == ":path") {
+        out.path = value;
+      } else if (name == ":method") {
+        out.method = value;
+      } else if (name == ":authority") {
+        out.authority = value;
+      } else if (name == ":scheme") {
+        out.scheme = value;
+      } else if (auto it = out.headers.find(name); name == "cookie" && it != out.headers.end()) {
+        it->second.append("; ").append(value);
+      } else {
+        out.headers[name] = value;
+      }
+    }
+    if (flags & NGHTTP2_HD_INFLATE_FINAL) {
+      break;
+    }
+  }
+  nghttp2_hd_inflate_end_headers(inflater);
+  return out;
+}
+
+std::optional<std::string> legacy_cookie(const LegacyParsed& parsed, std::string_view name) {
+  auto it = parsed.headers.find("cookie");
+  if (it == parsed.headers.end()) {
+    return std::nullopt;
+  }
+  std::string needle = std::string(name) + "=";
+  auto pos = it->second.find(needle);
+  if (pos == std::string::npos) {
+    return std::nullopt;
+  }
+  pos += needle.size();
+  return it->second.substr(pos, it->second.find(';', pos) - pos);
+}
+
+void bench_decode() {
+  auto blocks = make_request_blocks(kIterations);
+  std::printf("• request decode (%d blocks, one connection)\n", kIterations);
+
+  nghttp2_hd_inflater* inflater = nullptr;
+  nghttp2_hd_inflate_new(&inflater);
+  auto legacy = measure(kIterations, [&](int i) -> std::size_t {
+    const auto& block = blocks[static_cast<std::size_t>(i)];
+    auto parsed = legacy_decode(inflater, block);
+    return legacy_cookie(*parsed, "ns_session") ? block.size() : 0;
+  });
+  nghttp2_hd_inflate_del(inflater);
+  report("map + extract_cookie (before)", legacy);
+
+  HpackDecoder decoder;
+  HeaderView view;
+  auto current = measure(kIterations, [&](int i) -> std::size_t {
+    const auto& block = blocks[static_cast<std::size_t>(i)];
+    return decoder.decode(block, view) && view.cookie("ns_session") ? block.size() : 0;
+  });
+  report("HeaderView + cookie() (after)", current);
+  std::printf("  ↳ arena capacity after warm-up: %zu bytes\n", view.arena_capacity());
+}
+
+void bench_encode() {
+  std::printf("• response encode (%d responses, one connection)\n", kIterations);
+  const std::vector<std::pair<std::string_view, Headers>> responses = {
+      {"text/html; charset=utf-8",
+       {{"cache-control", "no-cache"}, {"vary", "accept-encoding"}}},
+      {"application/javascript",
+       {{"cache-control", "public, max-age=31536000, immutable"},
+        {"vary", "accept-encoding"}}},
+      {"application/json",
+       {{"cache-control", "no-store"},
+        {"set-cookie", "ns_debug=1; Path=/; Max-Age=3600; Secure; SameSite=Lax"}}},
+  };
+
+  std::vector<std::uint8_t> out;
+  out.reserve(4096);
+  auto legacy = measure(kIterations, [&](int i) -> std::size_t {
+    const auto& [content_type, extra] = responses[static_cast<std::size_t>(i) % responses.size()];
+    out.clear();
+    encode_response_headers(out, 200, content_type, extra);
+    return out.size();
+  });
+  report("literal, no Huffman (before)", legacy);
+
+  HpackEncoder encoder;
+  auto current = measure(kIterations, [&](int i) -> std::size_t {
+    const auto& [content_type, extra] = responses[static_cast<std::size_t>(i) % responses.size()];
+    out.clear();
+    encoder.encode(out, 200, content_type, extra);
+    return out.size();
+  });
+  report("HpackEncoder (after)", current);
+  std::printf("  ↳ %.1f%% fewer header bytes per response\n",
+              100.0 * (1.0 - current.bytes_per_op / legacy.bytes_per_op));
+}
+
+} // namespace
+
+int main() {
+  bench_decode();
+  bench_encode();
+  return 0;
+}
@@ -0,0 +1,481 @@
+// Micro-benchmarks for the per-request and per-tick hot paths.
+//
+//   micro_bench [--filter=<section>] [--json=<path>]
+//
+// Sections: frames, static_cache, router, vhost, cert_manager, tls, sse, connections,
+// metrics.
+// HPACK decode/encode lives in hpack_bench.
+
+#include "bench_support.h++"
+
+#include "neonsignal/logging.h++"
+#include "spin/cert_manager.h++"
+#include "spin/event_loop.h++"
+#include "spin/http2_listener.h++"
+#include "spin/http2_listener_helpers.h++"
+#include "spin/metrics.h++"
+#include "spin/router.h++"
+#include "spin/vhost.h++"
+
+#include <openssl/ssl.h>
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using namespace neonsignal;
+using namespace std::chrono_literals;
+using bench::measure;
+using bench::Report;
+
+std::vector<std::uint8_t> bytes_of(std::string_view text) {
+  return std::vector<std::uint8_t>(text.begin(), text.end());
+}
+
+void bench_frames(Report& report) {
+  std::printf("• response framing\n");
+  Http2Connection conn;
+  conn.write_buf.reserve(64 * 1024);
+  const auto small = bytes_of(bench::filler_text(1024));
+  const auto large = bytes_of(bench::filler_text(64 * 1024));
+  const std::vector<std::pair<std::string, std::string>> extra = {
+      {"cache-control", "no-store"},
+      {"set-cookie", "ns_debug=1; Path=/; Max-Age=3600; Secure; SameSite=Lax"}};
+
+  auto one_kib = measure(200'000, [&](std::uint64_t i) {
+    conn.write_buf.clear();
+    build_response_frames_with_headers(conn, static_cast<std::uint32_t>(2 * i + 1), 200,
+                                       "application/json", extra, small);
+    bench::keep(conn.write_buf);
+  });
+  bench::report_timing(report, "build_response_frames_with_headers 1 KiB", one_kib);
+
+  auto sixty_four_kib = measure(50'000, [&](std::uint64_t i) {
+    conn.write_buf.clear();
+    build_response_frames_with_headers(conn, static_cast<std::uint32_t>(2 * i + 1), 200,
+                                       "text/html; charset=utf-8", {}, large);
+    bench::keep(conn.write_buf);
+  });
+  bench::report_timing(report, "build_response_frames_with_headers 64 KiB", sixty_four_kib,
+                       {{"MiB_per_s", 64.0 / 1024.0 * 1e9 / sixty_four_kib.ns_per_op}});
+
+  auto frame = measure(500'000, [&](std::uint64_t i) {
+    auto out = build_frame(0x0, 0x1, static_cast<std::uint32_t>(2 * i + 1), small);
+    bench::keep(out);
+  });
+  bench::report_timing(report, "build_frame DATA 1 KiB", frame);
+}
+
+void bench_static_cache(Report& report) {
+  std::printf("• static cache\n");
+  constexpr int kEntries = 1000;
+  StaticFileCache cache(256 * 1024 * 1024);
+  std::vector<std::string> keys;
+  keys.reserve(kEntries);
+  for (int i = 0; i < kEntries; ++i) {
+    keys.push_back("/assets/chunk-" + std::to_string(i) + ".js");
+    cache.put(keys.back(), "/srv/www" + keys.back(),
+              bytes_of(bench::filler_text(4096, static_cast<std::uint32_t>(i))),
+              "application/javascript");
+  }
+
+  auto identity = measure(1'000'000, [&](std::uint64_t i) {
+    auto hit = cache.get(keys[i % kEntries]);
+    bench::keep(hit);
+  });
+  bench::report_timing(report, "StaticFileCache::get identity", identity);
+
+  const EncodingMask browser = parse_accept_encoding("gzip, deflate, br, zstd");
+  auto negotiated = measure(1'000'000, [&](std::uint64_t i) {
+    auto hit = cache.get(keys[i % kEntries], browser);
+    bench::keep(hit);
+  });
+  bench::report_timing(report, "StaticFileCache::get br/zstd/gzip", negotiated);
+
+  auto miss = measure(1'000'000, [&](std::uint64_t) {
+    auto hit = cache.get("/assets/missing.js", browser);
+    bench::keep(hit);
+  });
+  bench::report_timing(report, "StaticFileCache::get miss", miss);
+
+  // A full hit as the listener serves it: HEADERS append plus zero-copy body.
+  Http2Connection conn;
+  conn.write_buf.reserve(4096);
+  auto serve = measure(500'000, [&](std::uint64_t i) {
+    auto hit = cache.get(keys[i % kEntries], browser);
+    auto stream_id = static_cast<std::uint32_t>(2 * i + 1);
+    conn.write_buf.clear();
+    hit->append_headers(conn.write_buf, stream_id);
+    hit->queue_body(conn.flow, stream_id);
+    conn.flow.close_stream(stream_id);
+  });
+  bench::report_timing(report, "cached hit: append_headers + queue_body", serve);
+}
+
+void bench_router(Report& report) {
+  std::printf("• router\n");
+  bench::ScratchDir root("neonsignal-router");
+  bench::write_file(root.path() / "index.html", "<html></html>");
+  bench::write_file(root.path() / "assets" / "js" / "app.js", "export {};");
+  Router router(root.path());
+
+  auto home = measure(200'000, [&](std::uint64_t) { bench::keep(router.resolve("/")); });
+  bench::report_timing(report, "Router::resolve / (index.html)", home);
+
+  auto nested = measure(200'000, [&](std::uint64_t) {
+    bench::keep(router.resolve("/assets/js/app.js?v=42"));
+  });
+  bench::report_timing(report, "Router::resolve nested file", nested);
+
+  auto missing = measure(200'000, [&](std::uint64_t) {
+    bench::keep(router.resolve("/assets/js/missing.js"));
+  });
+  bench::report_timing(report, "Router::resolve missing", missing);
+}
+
+void bench_vhost(Report& report) {
+  std::printf("• virtual hosts\n");
+  constexpr int kHosts = 64;
+  bench::ScratchDir root("neonsignal-vhost");
+  for (int i = 0; i < kHosts; ++i) {
+    std::filesystem::create_directories(root.path() /
+                                        ("site-" + std::to_string(i) + ".example.com"));
+  }
+  std::filesystem::create_directories(root.path() / "_default");
+  VHostResolver resolver(root.path());
+
+  auto exact = measure(1'000'000, [&](std::uint64_t i) {
+    static const std::string authorities[] = {"site-7.example.com", "SITE-42.example.com:9443",
+                                              "site-63.example.com"};
+    bench::keep(resolver.resolve(authorities[i % 3]));
+  });
+  bench::report_timing(report, "VHostResolver::resolve exact", exact);
+
+  auto fallback = measure(1'000'000, [&](std::uint64_t) {
+    bench::keep(resolver.resolve("unknown.example.org"));
+  });
+  bench::report_timing(report, "VHostResolver::resolve _default", fallback);
+}
+
+void bench_cert_manager(Report& report) {
+  std::printf("• certificate selection (SNI)\n");
+  constexpr int kDomains = 32;
+  bench::ScratchDir root("neonsignal-certs");
+  bool ok = bench::write_self_signed_cert(root.path() / "_default", "localhost",
+                                          {"DNS:localhost", "IP:127.0.0.1"});
+  for (int i = 0; i < kDomains && ok; ++i) {
+    auto domain = "site-" + std::to_string(i) + ".example.com";
+    ok = bench::write_self_signed_cert(root.path() / domain, domain, {"DNS:" + domain});
+  }
+  ok = ok && bench::write_self_signed_cert(root.path() / "*.wild.example.com",
+                                           "*.wild.example.com", {"DNS:*.wild.example.com"});
+  ok = ok && bench::write_self_signed_cert(root.path() / "multi.example.net", "multi.example.net",
+                                           {"DNS:multi.example.net", "DNS:alias.example.net",
+                                            "DNS:*.apps.example.net"});
+  if (!ok) {
+    std::printf("  ✗ could not generate certificates\n");
+    return;
+  }
+
+  CertManager manager(root.path());
+  if (!manager.initialize()) {
+    std::printf("  ✗ CertManager failed to initialize\n");
+    return;
+  }
+
+  auto exact = measure(1'000'000, [&](std::uint64_t) {
+    bench::keep(manager.get_context("site-17.example.com"));
+  });
+  bench::report_timing(report, "CertManager::get_context exact", exact);
+
+  auto wildcard = measure(1'000'000, [&](std::uint64_t) {
+    bench::keep(manager.get_context("api.wild.example.com"));
+  });
+  bench::report_timing(report, "CertManager::get_context wildcard", wildcard);
+
+  auto san = measure(1'000'000, [&](std::uint64_t) {
+    bench::keep(manager.get_context("console.apps.example.net"));
+  });
+  bench::report_timing(report, "CertManager::get_context SAN wildcard", san);
+
+  auto fallback = measure(1'000'000, [&](std::uint64_t) {
+    bench::keep(manager.get_context("unknown.example.org"));
+  });
+  bench::report_timing(report, "CertManager::get_context default", fallback);
+}
+
+// SNI as Server::initialize_tls() wires it: switch to the certificate's context.
+int select_context(SSL* ssl, int*, void* arg) {
+  if (const char* name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name)) {
+    if (SSL_CTX* ctx = static_cast<CertManager*>(arg)->get_context(name)) {
+      SSL_set_SSL_CTX(ssl, ctx);
+    }
+  }
+  return SSL_TLSEXT_ERR_OK;
+}
+
+/**
+ * One TLS handshake over an in-memory BIO pair, so the cost is CPU only.
+ * Offers `resume` if given; returns the client's session afterwards (with
+ * the server's ticket) or null on failure.
+ */
+SSL_SESSION* memory_handshake(SSL_CTX* server_ctx, SSL_CTX* client_ctx, SSL_SESSION* resume,
+                              bool& reused) {
+  BIO* client_bio = nullptr;
+  BIO* server_bio = nullptr;
+  BIO_new_bio_pair(&client_bio, 0, &server_bio, 0);
+  SSL* client = SSL_new(client_ctx);
+  SSL* server = SSL_new(server_ctx);
+  SSL_set_bio(client, client_bio, client_bio);
+  SSL_set_bio(server, server_bio, server_bio);
+  SSL_set_connect_state(client);
+  SSL_set_accept_state(server);
+  SSL_set_tlsext_host_name(client, "site-3.example.com");
+  if (resume) {
+    SSL_set_session(client, resume);
+  }
+
+  bool client_done = false;
+  bool server_done = false;
+  for (int round = 0; round < 16 && !(client_done && server_done); ++round) {
+    client_done = client_done || SSL_do_handshake(client) == 1;
+    server_done = server_done || SSL_do_handshake(server) == 1;
+  }
+  SSL_SESSION* session = nullptr;
+  if (client_done && server_done) {
+    // TLS 1.3 tickets arrive after the handshake; a read consumes them.
+    unsigned char byte = 0;
+    SSL_read(client, &byte, 1);
+    reused = SSL_session_reused(client) == 1;
+    session = SSL_get1_session(client);
+    // Without close_notify OpenSSL would mark the session unresumable.
+    SSL_shutdown(client);
+    SSL_shutdown(server);
+  }
+  SSL_free(client);
+  SSL_free(server);
+  return session;
+}
+
+void bench_tls(Report& report) {
+  std::printf("• TLS handshakes (in-memory, SNI context switch)\n");
+  bench::ScratchDir root("neonsignal-tls");
+  bool ok = bench::write_self_signed_cert(root.path() / "_default", "localhost",
+                                          {"DNS:localhost", "IP:127.0.0.1"});
+  for (int i = 0; i < 8 && ok; ++i) {
+    auto domain = "site-" + std::to_string(i) + ".example.com";
+    ok = bench::write_self_signed_cert(root.path() / domain, domain, {"DNS:" + domain});
+  }
+  if (!ok) {
+    std::printf("  ✗ could not generate certificates\n");
+    return;
+  }
+  CertManager manager(root.path());
+  if (!manager.initialize()) {
+    std::printf("  ✗ CertManager failed to initialize\n");
+    return;
+  }
+  SSL_CTX* server_ctx = manager.get_default_context();
+  SSL_CTX_set_tlsext_servername_callback(server_ctx, select_context);
+  SSL_CTX_set_tlsext_servername_arg(server_ctx, &manager);
+
+  std::unique_ptr<SSL_CTX, decltype(&SSL_CTX_free)> client_ctx(SSL_CTX_new(TLS_client_method()),
+                                                               &SSL_CTX_free);
+  SSL_CTX_set_verify(client_ctx.get(), SSL_VERIFY_NONE, nullptr);
+  static const unsigned char alpn[] = {0x02, 'h', '2'};
+  SSL_CTX_set_alpn_protos(client_ctx.get(), alpn, sizeof(alpn));
+
+  bool reused = false;
+  SSL_SESSION* session = memory_handshake(server_ctx, client_ctx.get(), nullptr, reused);
+  if (!session) {
+    std::printf("  ✗ handshake failed\n");
+    return;
+  }
+
+  std::uint64_t failures = 0;
+  auto full = measure(500, [&](std::uint64_t) {
+    bool r = false;
+    SSL_SESSION* s = memory_handshake(server_ctx, client_ctx.get(), nullptr, r);
+    failures += s ? 0 : 1;
+    SSL_SESSION_free(s);
+  });
+  bench::report_timing(report, "TLS 1.3 handshake full", full,
+                       {{"failures", static_cast<double>(failures)}});
+
+  // Each resumption hands out a fresh ticket; chain them like a browser does.
+  std::uint64_t attempts = 0;
+  std::uint64_t resumed = 0;
+  auto resume = measure(500, [&](std::uint64_t) {
+    ++attempts;
+    bool r = false;
+    SSL_SESSION* next = memory_handshake(server_ctx, client_ctx.get(), session, r);
+    resumed += r ? 1 : 0;
+    if (next) {
+      SSL_SESSION_free(session);
+      session = next;
+    }
+  });
+  bench::report_timing(report, "TLS 1.3 handshake resumed", resume,
+                       {{"resumed_ratio",
+                         static_cast<double>(resumed) / static_cast<double>(attempts)}});
+  SSL_SESSION_free(session);
+}
+
+// Timer-driven fan-out: every tick encodes the payload once and appends it to
+// each subscriber's staging buffer. Reported as loop-thread CPU per tick.
+void bench_sse(Report& report) {
+  std::printf("• SSE fan-out\n");
+  for (std::size_t subscribers : {1'000UL, 10'000UL}) {
+    EventLoop loop;
+    std::atomic<std::uint64_t> event_clients{0};
+    SSEResetPolicy policy{SSEResetPolicy::Mode::OnlyTime, std::chrono::hours(24), 0};
+    SSEBroadcaster broadcaster(loop, policy, ConnectionManager::MAX_WRITE_BUFFER_BYTES,
+                               event_clients);
+
+    std::vector<std::shared_ptr<Http2Connection>> conns;
+    conns.reserve(subscribers);
+    std::uint64_t ticks = 0;
+    broadcaster.set_channel(SSEBroadcaster::Channel::Events,
+                            {1ms, SSEBroadcaster::Backpressure::Coalesce, false}, [&]() {
+                              // The previous tick's frames count as written.
+                              for (auto& conn : conns) {
+                                conn->write_buf.clear();
+                              }
+                              return "data: {\"tick\": " + std::to_string(++ticks) + "}\n\n";
+                            });
+
+    for (std::size_t i = 0; i < subscribers; ++i) {
+      auto conn = std::make_shared<Http2Connection>();
+      conn->fd = static_cast<int>(100'000 + i); // never polled
+      conn->events = EventMask::Read | EventMask::Write;
+      conn->write_buf.reserve(128);
+      conns.push_back(conn);
+      broadcaster.subscribe(SSEBroadcaster::Channel::Events, conn, 1);
+    }
+
+    broadcaster.start();
+    loop.add_timer(2s, [&]() { loop.stop(); });
+    ticks = 0;
+    auto cpu_before = bench::thread_cpu_time();
+    loop.run();
+    auto cpu = bench::thread_cpu_time() - cpu_before;
+    broadcaster.stop();
+
+    double ns_per_tick = ticks ? static_cast<double>(cpu.count()) / static_cast<double>(ticks) : 0;
+    std::printf("  %-44s %12.1f ns/tick %8.1f ns/subscriber\n",
+                ("tick, " + std::to_string(subscribers) + " subscribers").c_str(), ns_per_tick,
+                ns_per_tick / static_cast<double>(subscribers));
+    report.add("SSEBroadcaster tick " + std::to_string(subscribers) + " subscribers",
+               {{"ns_per_tick", ns_per_tick},
+                {"ns_per_subscriber", ns_per_tick / static_cast<double>(subscribers)},
+                {"ticks", static_cast<double>(ticks)}});
+  }
+}
+
+void bench_connections(Report& report) {
+  std::printf("• connection timeouts\n");
+  constexpr std::size_t kConnections = ConnectionManager::MAX_CONNECTIONS;
+  ConnectionManager manager;
+  auto now = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < kConnections; ++i) {
+    const int fd = static_cast<int>(i + 3);
+    auto conn = std::make_shared<Http2Connection>();
+    conn->fd = fd;
+    conn->handshake_complete = true;
+    // 1% idle past the limit
+    if (i % 100 == 0) {
+      conn->last_activity = now - ConnectionManager::IDLE_TIMEOUT - 1s;
+    }
+    manager.register_connection(fd, std::move(conn));
+  }
+
+  std::size_t found = 0;
+  auto scan = measure(2'000, [&](std::uint64_t) {
+    auto timed_out = manager.find_timed_out_connections();
+    found = timed_out.size();
+    bench::keep(timed_out);
+  });
+  bench::report_timing(report, "find_timed_out_connections 10k", scan,
+                       {{"timed_out", static_cast<double>(found)},
+                        {"ns_per_connection", scan.ns_per_op / kConnections}});
+}
+
+// Instrument updates on the request path, a scrape, and a log line that is
+// filtered out vs. one handed to the drain thread (written to stderr).
+void bench_metrics(Report& report) {
+  std::printf("• metrics and logging\n");
+  MetricsRegistry registry;
+  ServerMetrics metrics(registry);
+  for (int i = 0; i < 16; ++i) {
+    metrics.vhost_requests("vhost" + std::to_string(i)).add();
+  }
+
+  auto counter = measure(10'000'000, [&](std::uint64_t) { metrics.count_status(200); });
+  bench::report_timing(report, "ServerMetrics::count_status", counter);
+  auto histogram =
+      measure(10'000'000, [&](std::uint64_t i) { metrics.first_byte.record(i & 0xFFFF); });
+  bench::report_timing(report, "Histogram::record", histogram);
+  auto scrape = measure(2'000, [&](std::uint64_t) { bench::keep(registry.prometheus_text()); });
+  bench::report_timing(report, "MetricsRegistry::prometheus_text", scrape);
+
+  install_async_logging();
+  set_log_level(LogLevel::warn);
+  auto filtered = measure(1'000'000, [&](std::uint64_t i) {
+    std::cerr << "• HEADERS on fd=" << 7 << " stream=" << i << " path=/index.html\n";
+  });
+  bench::report_timing(report, "log line below threshold", filtered);
+  auto guarded = measure(10'000'000, [&](std::uint64_t i) {
+    if (log_enabled(LogLevel::debug)) {
+      std::cerr << "• HEADERS on fd=" << 7 << " stream=" << i << " path=/index.html\n";
+    }
+  });
+  bench::report_timing(report, "log line behind log_enabled(debug)", guarded);
+  set_log_level(LogLevel::info);
+  auto queued = measure(2'000, [&](std::uint64_t i) {
+    std::cerr << "• micro_bench log line " << i << '\n';
+  });
+  bench::report_timing(report, "log line queued", queued,
+                       {{"dropped", static_cast<double>(dropped_log_lines())}});
+}
+
+struct Section {
+  std::string_view name;
+  void (*run)(Report&);
+};
+
+constexpr Section kSections[] = {
+    {"frames", bench_frames},         {"static_cache", bench_static_cache},
+    {"router", bench_router},         {"vhost", bench_vhost},
+    {"cert_manager", bench_cert_manager}, {"tls", bench_tls},
+    {"sse", bench_sse},               {"connections", bench_connections},
+    {"metrics", bench_metrics},
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  auto filter = bench::arg_value(argc, argv, "filter");
+  auto json = bench::arg_value(argc, argv, "json");
+
+  Report report("micro");
+  report.set_param("filter", filter.empty() ? "all" : filter);
+  for (const auto& section : kSections) {
+    if (filter.empty() || filter == section.name) {
+      section.run(report);
+    }
+  }
+
+  if (!json.empty()) {
+    if (!report.write_json(json)) {
+      std::fprintf(stderr, "✗ could not write %s\n", json.c_str());
+      return 1;
+    }
+    std::printf("✓ results written to %s\n", json.c_str());
+  }
+  return 0;
+}
@@ -1,9 +1,40 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 namespace neonsignal {
 
-// Install a streambuf on std::cerr that prefixes each log line with the current
-// thread name (pthread name if set, otherwise thread id).
-void install_thread_logging_prefix();
+enum class LogLevel : int { debug, info, warn, error, off };
+
+namespace detail {
+extern std::atomic<int> log_level;
+} // namespace detail
+
+/**
+ * Replace std::cerr's buffer with an asynchronous logger.
+ *
+ * Each thread assembles its line privately, prefixed with the thread name
+ * (pthread name if set, otherwise thread id); completed lines go into a
+ * bounded lock-free ring that a background thread drains to the original
+ * stderr in batches. A full ring drops the line instead of blocking, and the
+ * drain thread reports how many were lost.
+ *
+ * Lines are filtered by their leading symbol: "✗" is error, "▲" is warn,
+ * anything else is info. Per-request chatter is guarded by
+ * log_enabled(LogLevel::debug) at the call site so it costs nothing when off.
+ * The threshold comes from NEONSIGNAL_LOG_LEVEL (debug, info, warn, error,
+ * off) and defaults to info.
+ */
+void install_async_logging();
+
+void set_log_level(LogLevel level);
+
+[[nodiscard]] inline bool log_enabled(LogLevel level) {
+  return static_cast<int>(level) >= detail::log_level.load(std::memory_order_relaxed);
+}
+
+// Lines lost to a full ring since startup
+[[nodiscard]] std::uint64_t dropped_log_lines();
 
 } // namespace neonsignal
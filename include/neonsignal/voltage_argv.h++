@@ -22,6 +22,7 @@ public:
 
   // Configuration accessors
   [[nodiscard]] const std::optional<unsigned long long> &threads() const;
+  [[nodiscard]] const std::optional<unsigned long long> &reactors() const;
   [[nodiscard]] const std::optional<std::string> &host() const;
   [[nodiscard]] const std::optional<unsigned long long> &port() const;
   [[nodiscard]] const std::optional<std::string> &webauthn_domain() const;
@@ -50,6 +51,7 @@ private:
   std::optional<std::string> help_text_;
   std::optional<std::string> version_text_;
   std::optional<unsigned long long> threads_;
+  std::optional<unsigned long long> reactors_;
   std::optional<std::string> host_;
   std::optional<unsigned long long> port_;
   std::optional<std::string> webauthn_domain_;
@@ -16,6 +16,7 @@ public:
 
   // Server options
   [[nodiscard]] unsigned long long threads() const;
+  [[nodiscard]] unsigned long long reactors() const;
   [[nodiscard]] std::string host() const;
   [[nodiscard]] unsigned long long port() const;
   [[nodiscard]] std::string webauthn_domain() const;
@@ -19,6 +19,7 @@ private:
 
     // Server options
     threads,
+    reactors,
     host,
     port,
     webauthn_domain,
@@ -88,6 +89,7 @@ private:
   [[nodiscard]] std::string help_() const;
   [[nodiscard]] std::string version_() const;
   [[nodiscard]] std::string threads_() const;
+  [[nodiscard]] std::string reactors_() const;
   [[nodiscard]] std::string host_() const;
   [[nodiscard]] std::string port_() const;
   [[nodiscard]] std::string webauthn_domain_() const;
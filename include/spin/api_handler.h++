@@ -6,6 +6,7 @@
 #include "spin/mail_config.h++"
 #include "spin/mail_cookie_store.h++"
 #include "spin/mail_service.h++"
+#include "spin/metrics.h++"
 
 #include <atomic>
 #include <memory>
@@ -25,15 +26,16 @@ public:
     std::string session_id;
   };
 
-  ApiHandler(EventLoop& loop, WebAuthnManager& auth, const Router& router,
+  ApiHandler(EventLoop& loop, ThreadPool& pool, WebAuthnManager& auth, const Router& router,
              Database& db,
              std::atomic<std::uint64_t>& served_files,
              std::atomic<std::uint64_t>& page_views,
-             std::atomic<std::uint64_t>& event_clients,
+             SSEBroadcaster& sse,
              std::atomic<bool>& redirect_ok,
              MailService& mail_service,
              MailCookieStore& mail_cookie_store,
-             const MailConfig& mail_config);
+             const MailConfig& mail_config,
+             const MetricsRegistry& metrics);
 
   bool auth_login_options(const std::shared_ptr<Http2Connection>& conn,
                                  std::uint32_t stream_id);
@@ -43,7 +45,7 @@ public:
                                         const std::string& method);
   bool auth_user_check(const std::shared_ptr<Http2Connection>& conn,
                        std::uint32_t stream_id,
-                       const std::unordered_map<std::string, std::string>& headers);
+                       const HeaderView& headers);
   bool user_register_headers(const std::shared_ptr<Http2Connection>& conn,
                              std::uint32_t stream_id,
                              const std::string& path,
@@ -56,22 +58,22 @@ public:
   ApiResponse user_verify_finish(std::span<const std::uint8_t> payload);
   bool user_enroll(const std::shared_ptr<Http2Connection>& conn,
                    std::uint32_t stream_id,
-                   const std::unordered_map<std::string, std::string>& headers);
+                   const HeaderView& headers);
   bool user_enroll_headers(const std::shared_ptr<Http2Connection>& conn,
                            std::uint32_t stream_id,
-                           const std::unordered_map<std::string, std::string>& headers,
+                           const HeaderView& headers,
                            const std::string& path,
                            const std::string& method);
   ApiResponse user_enroll_finish(std::uint64_t user_id,
                                  std::span<const std::uint8_t> payload);
   bool codex_brief_headers(const std::shared_ptr<Http2Connection>& conn,
                            std::uint32_t stream_id,
-                           const std::unordered_map<std::string, std::string>& headers,
+                           const HeaderView& headers,
                            const std::string& path, const std::string& method);
   ApiResponse codex_brief_finish(std::string_view content_type,
                                  std::span<const std::uint8_t> payload);
   bool codex_list(const std::shared_ptr<Http2Connection>& conn,
-                  std::uint32_t stream_id);
+                  std::uint32_t stream_id, const std::string& path);
   bool codex_item(const std::shared_ptr<Http2Connection>& conn,
                   std::uint32_t stream_id, const std::string& path);
   bool codex_image(const std::shared_ptr<Http2Connection>& conn,
@@ -93,7 +95,7 @@ public:
                             const std::string& path);
   bool mail_send_headers(const std::shared_ptr<Http2Connection>& conn,
                          std::uint32_t stream_id,
-                         const std::unordered_map<std::string, std::string>& headers,
+                         const HeaderView& headers,
                          const std::string& path,
                          const std::string& method,
                          const std::string& authority);
@@ -119,20 +121,29 @@ public:
                                       const std::string& path,
                                       const std::string& method,
                                       const std::string& authority);
+  // Prometheus text exposition
+  bool metrics(const std::shared_ptr<Http2Connection>& conn, std::uint32_t stream_id,
+               const std::string& path, const std::string& method,
+               const std::string& authority);
+  bool metrics_stream(const std::shared_ptr<Http2Connection>& conn, std::uint32_t stream_id,
+                      const std::string& path, const std::string& method,
+                      const std::string& authority);
 
 private:
   EventLoop& loop_;
+  ThreadPool& pool_; // Database queries run here, completions return to loop_
   WebAuthnManager& auth_;
   const Router& router_;
   Database& db_;
   std::atomic<std::uint64_t>& served_files_;
   std::atomic<std::uint64_t>& page_views_;
-  std::atomic<std::uint64_t>& event_clients_;
+  SSEBroadcaster& sse_;
   std::atomic<bool>& redirect_service_ok_;
   CodexRunner codex_runner_;
   MailService& mail_service_;
   MailCookieStore& mail_cookie_store_;
   const MailConfig& mail_config_;
+  const MetricsRegistry& metrics_;
 };
 
 } // namespace neonsignal
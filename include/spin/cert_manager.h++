@@ -1,6 +1,10 @@
 #pragma once
 
+#include "spin/session_ticket_keys.h++"
+
+#include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <shared_mutex>
@@ -26,9 +30,23 @@ struct CertificateBundle {
   std::time_t not_after{0};
 };
 
+/**
+ * One SSL_CTX per certificate directory under the certs root, selected by SNI.
+ *
+ * Every hostname a certificate covers (directory name, subjectAltNames,
+ * wildcards) is indexed when certificates are loaded, so get_context() is an
+ * exact hash probe plus at most one wildcard probe. All contexts share one
+ * session id context, resumption cache policy and set of rotating ticket
+ * keys, so a client resumes no matter which context SNI picked, and none of
+ * them accept 0-RTT data. With `enable_ktls` they also ask OpenSSL for kernel
+ * TLS, which lets file bodies go out with SSL_sendfile().
+ */
 class CertManager {
 public:
-  explicit CertManager(std::filesystem::path certs_root);
+  // Stateful cache entries per context (tickets need no server state)
+  static constexpr long kSessionCacheSize = 20'480;
+
+  explicit CertManager(std::filesystem::path certs_root, bool enable_ktls = false);
 
   bool initialize();
   SSL_CTX *get_context(std::string_view hostname) const;
@@ -38,19 +56,32 @@ public:
   [[nodiscard]] std::vector<std::string> expiring_soon(int days = 30) const;
 
 private:
+  struct HostHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view host) const noexcept {
+      return std::hash<std::string_view>{}(host);
+    }
+  };
+
   std::filesystem::path certs_root_;
+  bool ktls_{false};
+  SessionTicketKeys ticket_keys_; // outlives reloads so issued tickets stay valid
   mutable std::shared_mutex mutex_;
 
   std::unordered_map<std::string, std::unique_ptr<CertificateBundle>>
       exact_certs_;
   std::vector<std::unique_ptr<CertificateBundle>> wildcard_certs_;
   CertificateBundle *default_cert_{nullptr};
+  // Lowercase hostname -> context; wildcards are keyed by their ".suffix".
+  std::unordered_map<std::string, SSL_CTX *, HostHash, std::equal_to<>> hosts_;
 
   std::unique_ptr<CertificateBundle>
   load_certificate(const std::filesystem::path &cert_dir,
                    const std::string &domain);
 
   bool configure_ssl_ctx(CertificateBundle &bundle);
+  void configure_resumption(SSL_CTX *ctx);
+  void index_hostnames();
   bool extract_cert_info(CertificateBundle &bundle);
 
   static std::string normalize_hostname(std::string_view hostname);
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace neonsignal {
+
+/**
+ * Content codings NeonSignal can serve. Values double as indices into
+ * per-variant tables and as bit positions in an EncodingMask.
+ */
+enum class ContentEncoding : std::uint8_t { identity = 0, gzip, br, zstd };
+
+inline constexpr std::size_t kContentEncodingCount = 4;
+
+// Bitmask of ContentEncoding values a client accepts (identity always set).
+using EncodingMask = std::uint8_t;
+
+[[nodiscard]] constexpr EncodingMask encoding_bit(ContentEncoding encoding) {
+  return static_cast<EncodingMask>(1U << static_cast<unsigned>(encoding));
+}
+
+inline constexpr EncodingMask kIdentityOnly = encoding_bit(ContentEncoding::identity);
+
+/**
+ * Token used in the content-encoding header ("br", "gzip", "zstd", "identity").
+ */
+[[nodiscard]] std::string_view content_encoding_token(ContentEncoding encoding);
+
+/**
+ * Sibling file suffix for a precompressed variant (".br", ".gz", ".zst").
+ * Empty for identity.
+ */
+[[nodiscard]] std::string_view content_encoding_suffix(ContentEncoding encoding);
+
+/**
+ * Parse an accept-encoding header value. Codings listed with q=0 are treated
+ * as refused; any other q-value counts as accepted.
+ *
+ * @param header Raw header value (may be empty).
+ * @return Mask of accepted codings, always including identity.
+ */
+[[nodiscard]] EncodingMask parse_accept_encoding(std::string_view header);
+
+/**
+ * Whether a MIME type benefits from compression (text, JS, JSON, SVG, ...).
+ */
+[[nodiscard]] bool is_compressible_mime(std::string_view mime_type);
+
+/**
+ * Whether this build can produce `encoding` itself (brotli and zstd are
+ * optional dependencies; gzip is always available).
+ */
+[[nodiscard]] bool can_compress(ContentEncoding encoding);
+
+/**
+ * Compress a buffer with the given coding.
+ *
+ * @return Compressed bytes, or std::nullopt if the coding is unavailable or
+ *         the encoder failed.
+ */
+[[nodiscard]] std::optional<std::vector<std::uint8_t>>
+compress_content(ContentEncoding encoding, std::span<const std::uint8_t> input);
+
+} // namespace neonsignal
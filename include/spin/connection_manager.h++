@@ -29,11 +29,13 @@ public:
   static constexpr std::chrono::seconds HANDSHAKE_TIMEOUT{10};
   static constexpr std::chrono::seconds IDLE_TIMEOUT{300};  // 5 minutes
 
-  ConnectionManager() = default;
+  // max_connections lets each reactor shard enforce its slice of MAX_CONNECTIONS
+  explicit ConnectionManager(std::size_t max_connections = MAX_CONNECTIONS)
+      : max_connections_(max_connections) {}
 
   // Check if we can accept a new connection
   [[nodiscard]] bool can_accept_connection() const {
-    return connection_count_.load(std::memory_order_relaxed) < MAX_CONNECTIONS;
+    return connection_count_.load(std::memory_order_relaxed) < max_connections_;
   }
 
   // Register a new connection
@@ -103,14 +105,14 @@ public:
     std::size_t total = 0;
     std::lock_guard lock(mutex_);
     for (const auto& [_, conn] : connections_) {
-      total += conn->write_buf.size();
+      total += conn->pending_write_bytes();
     }
     return total;
   }
 
   // Check write buffer backpressure
   [[nodiscard]] bool has_write_backpressure(const std::shared_ptr<Http2Connection>& conn) const {
-    return conn->write_buf.size() > MAX_WRITE_BUFFER_BYTES;
+    return conn->pending_write_bytes() > MAX_WRITE_BUFFER_BYTES;
   }
 
   // Clear all connections (for shutdown)
@@ -137,6 +139,7 @@ private:
   mutable std::mutex mutex_;
   std::unordered_map<int, std::shared_ptr<Http2Connection>> connections_;
   std::atomic<std::size_t> connection_count_{0};
+  std::size_t max_connections_;
 };
 
 } // namespace neonsignal
@@ -1,12 +1,19 @@
 #pragma once
 
+#include "spin/event_loop.h++"
+#include "spin/thread_pool.h++"
+
 #include <chrono>
 #include <cstdint>
 #include <ctime>
+#include <exception>
+#include <memory>
 #include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <mdbx.h++>
@@ -59,6 +66,13 @@ struct CodexRecord {
   std::uint64_t image_size{};
 };
 
+// One page of codex records, newest first. `next_cursor` is empty on the last
+// page; otherwise pass it back to list_codex_page() for the next one.
+struct CodexPage {
+  std::vector<CodexRecord> items;
+  std::string next_cursor;
+};
+
 struct CodexBrief {
   std::string title;
   std::string meta_tags;
@@ -156,6 +170,8 @@ public:
   std::optional<std::vector<std::uint8_t>> fetch_codex_payload(std::string_view id);
   std::optional<std::vector<std::uint8_t>> fetch_codex_image(std::string_view id);
   std::vector<CodexRecord> list_codex(std::size_t limit);
+  // Keyset pagination over the created_at index
+  CodexPage list_codex_page(std::size_t limit, std::string_view cursor = {});
 
   std::optional<CodexRun> create_codex_run(std::string_view brief_id,
                                            std::string_view cmdline);
@@ -179,20 +195,40 @@ public:
   bool set_config(std::string_view key, std::string_view value);
   bool delete_config(std::string_view key);
 
+  // Run `query(*this)` on a pool thread and hand its result to `done` on the
+  // loop's thread. `done` receives std::nullopt if the query threw.
+  template <typename Query, typename Done>
+  void async(ThreadPool& pool, EventLoop& loop, Query query, Done done) {
+    using Result = std::invoke_result_t<Query&, Database&>;
+    pool.enqueue([this, &loop, query = std::move(query), done = std::move(done)]() mutable {
+      auto result = std::make_shared<std::optional<Result>>();
+      try {
+        result->emplace(query(*this));
+      } catch (const std::exception& e) {
+        log_query_error_(e);
+      }
+      loop.post([done = std::move(done), result]() mutable { done(std::move(*result)); });
+    });
+  }
+
 private:
   void open_maps_();
+  // Re-encode JSON values as binary records and build derived indexes/counters
+  void migrate_();
+  static void log_query_error_(const std::exception& e);
   static std::string generate_session_id_();
   static std::string generate_verification_token_();
 
   mdbx::env_managed env_;
-  mdbx::map_handle users_map_;           // user_id → user JSON
+  mdbx::map_handle users_map_;           // user_id → user record
   mdbx::map_handle emails_map_;          // email → user_id
   mdbx::map_handle credentials_map_;     // credential_id → user_id
   mdbx::map_handle usernames_map_;       // legacy: username → credential_id
   mdbx::map_handle sessions_map_;
-  mdbx::map_handle verifications_map_;   // token_hash → verification JSON
+  mdbx::map_handle verifications_map_;   // token_hash → verification record
   mdbx::map_handle config_map_;
   mdbx::map_handle codex_meta_map_;
+  mdbx::map_handle codex_by_created_map_; // created_at ‖ id (big-endian) → codex id
   mdbx::map_handle codex_payloads_map_;
   mdbx::map_handle codex_images_map_;
   mdbx::map_handle codex_runs_map_;
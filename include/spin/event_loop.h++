@@ -10,6 +10,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace neonsignal {
 
@@ -43,7 +44,10 @@ public:
   // Add signal handler for graceful shutdown
   void add_signal(int signum, std::function<void()> callback);
 
-  // Check if running
+  // Run `task` on the loop thread; safe to call from any thread
+  void post(std::function<void()> task);
+
+  // False once stop() has been called (possibly before run())
   [[nodiscard]] bool is_running() const { return running_.load(std::memory_order_relaxed); }
 
   // Get active FD count
@@ -53,11 +57,19 @@ public:
   }
 
 private:
+  void run_posted_();
+
   std::unique_ptr<EventLoopBackend> backend_;
-  std::atomic<bool> running_{false};
+  std::atomic<bool> running_{true}; // cleared by stop(); run() never re-arms it
   std::atomic<bool> shutdown_requested_{false};
   mutable std::mutex callbacks_mutex_;
   std::unordered_map<int, std::function<void(std::uint32_t)>> callbacks_;
+
+  // Self-pipe that wakes the loop for posted tasks
+  int wake_read_fd_{-1};
+  int wake_write_fd_{-1};
+  std::mutex posted_mutex_;
+  std::vector<std::function<void()>> posted_;
 };
 
 } // namespace neonsignal
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace neonsignal {
+
+/**
+ * Decoded request header block.
+ *
+ * Names and values are string_views into a per-connection arena that is
+ * rewound (not freed) for every header block, so steady-state decoding does
+ * not allocate. Views stay valid until the next block is decoded into the
+ * same HeaderView: copy anything that must outlive the HEADERS frame.
+ */
+class HeaderView {
+public:
+  struct Field {
+    std::string_view name;
+    std::string_view value;
+  };
+
+  // Pseudo-headers
+  std::string_view method;
+  std::string_view path;
+  std::string_view authority;
+  std::string_view scheme;
+
+  // Forget the previous block, keeping the arena and field storage
+  void clear();
+  // Copy bytes into the arena; `lowercase` folds ASCII for header names
+  [[nodiscard]] std::string_view store(const std::uint8_t* data, std::size_t len,
+                                       bool lowercase = false);
+  void add(std::string_view name, std::string_view value) { fields_.push_back({name, value}); }
+
+  // First value of a regular header (`name` must be lowercase)
+  [[nodiscard]] std::optional<std::string_view> get(std::string_view name) const;
+  // Cookie `name`, searched across every cookie field (HTTP/2 may split them)
+  [[nodiscard]] std::optional<std::string_view> cookie(std::string_view name) const;
+
+  [[nodiscard]] const std::vector<Field>& fields() const { return fields_; }
+  // Bytes reserved by the arena (for benchmarks and metrics)
+  [[nodiscard]] std::size_t arena_capacity() const;
+
+private:
+  static constexpr std::size_t kChunkBytes = 4096;
+
+  std::vector<Field> fields_;
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  std::size_t chunk_index_{0};
+  std::size_t chunk_used_{0};
+  // Values larger than a chunk get their own buffer, dropped by clear()
+  std::vector<std::unique_ptr<char[]>> oversized_;
+  std::size_t oversized_bytes_{0};
+};
+
+} // namespace neonsignal
@@ -1,30 +1,22 @@
 #pragma once
 
+#include "spin/header_view.h++"
+
 #include <nghttp2/nghttp2.h>
 
 #include <cstdint>
-#include <optional>
-#include <string>
-#include <unordered_map>
-#include <vector>
+#include <span>
 
 namespace neonsignal {
 
-struct ParsedHeaders {
-  std::string method;
-  std::string path;
-  std::string authority;
-  std::string scheme;
-  std::unordered_map<std::string, std::string> headers;
-};
-
 class HpackDecoder {
 public:
   HpackDecoder();
   ~HpackDecoder();
 
-  // Returns std::nullopt on decode failure.
-  std::optional<ParsedHeaders> decode(const std::vector<std::uint8_t>& block) const;
+  // Decode one header block into `out` (cleared first). Returns false on
+  // decode failure or a missing :path.
+  bool decode(std::span<const std::uint8_t> block, HeaderView& out) const;
 
 private:
   nghttp2_hd_inflater* inflater_{nullptr};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <nghttp2/nghttp2.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace neonsignal {
+
+/**
+ * Stateful HPACK encoder for one connection's responses (RFC 7541).
+ *
+ * Wraps nghttp2's deflater, so repeated fields (content-type, cache-control,
+ * vary, ...) are sent as one-byte dynamic table references after their first
+ * occurrence and literals are Huffman-coded. set-cookie is always emitted as
+ * never-indexed. Header blocks must reach the peer in the order they were
+ * encoded; the staging buffer preserves that.
+ */
+class HpackEncoder {
+public:
+  // Our table size, and the peer's default SETTINGS_HEADER_TABLE_SIZE
+  static constexpr std::size_t kTableSize = 4096;
+
+  HpackEncoder();
+  ~HpackEncoder();
+
+  HpackEncoder(const HpackEncoder&) = delete;
+  HpackEncoder& operator=(const HpackEncoder&) = delete;
+
+  // Append the header block for a response to `out`. Falls back to stateless
+  // literals if the deflater is unavailable.
+  void encode(std::vector<std::uint8_t>& out, int status, std::string_view content_type,
+              const std::vector<std::pair<std::string, std::string>>& extra_headers);
+  // Peer SETTINGS_HEADER_TABLE_SIZE; the size update goes out with the next
+  // block.
+  void set_max_table_size(std::uint32_t size);
+
+private:
+  nghttp2_hd_deflater* deflater_{nullptr};
+  std::vector<nghttp2_nv> nva_; // reused per block
+};
+
+} // namespace neonsignal
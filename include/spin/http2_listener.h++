@@ -4,6 +4,9 @@
 #include "spin/database.h++"
 #include "spin/event_mask.h++"
 #include "spin/hpack_decoder.h++"
+#include "spin/hpack_encoder.h++"
+#include "spin/outbound_flow.h++"
+#include "spin/read_buffer.h++"
 #include "spin/vhost.h++"
 #include "spin/webauthn.h++"
 
@@ -24,6 +27,8 @@ struct ssl_st;
 
 namespace neonsignal {
 
+struct ServerMetrics;
+
 struct Http2Connection {
   int fd{-1};
   std::unique_ptr<SSL, decltype(&SSL_free)> ssl{nullptr, &SSL_free};
@@ -31,9 +36,10 @@ struct Http2Connection {
   bool preface_ok{false};
   bool client_settings_seen{false};
   bool server_settings_sent{false};
-  std::vector<std::uint8_t> read_buf;
-  std::vector<std::uint8_t> write_buf;
-  std::size_t write_offset{0};
+  ReadBuffer read_buf;
+  std::vector<std::uint8_t> write_buf; // Frames staged by handlers since the last flush
+  WriteQueue send_queue;
+  OutboundFlow flow;
   std::uint32_t events{EventMask::Read};
   bool closed{false};
   std::string last_path = "/";
@@ -41,27 +47,8 @@ struct Http2Connection {
   std::chrono::steady_clock::time_point handshake_deadline{};
   bool first_header_logged{false};
   std::unique_ptr<HpackDecoder> decoder;
-
-  // SSE stream tracking
-  bool is_event_stream{false};
-  std::uint32_t event_stream_id{0};
-  std::uint64_t event_sse_count{0};
-  std::chrono::steady_clock::time_point event_sse_start{};
-  bool is_cpu_stream{false};
-  std::uint32_t cpu_stream_id{0};
-  std::uint64_t last_cpu_time_ns{0};
-  std::chrono::steady_clock::time_point last_cpu_wall{};
-  std::uint64_t cpu_sse_count{0};
-  std::chrono::steady_clock::time_point cpu_sse_start{};
-  bool is_mem_stream{false};
-  std::uint32_t mem_stream_id{0};
-  std::uint64_t last_rss_kb{0};
-  std::uint64_t mem_sse_count{0};
-  std::chrono::steady_clock::time_point mem_sse_start{};
-  bool is_redirect_stream{false};
-  std::uint32_t redirect_stream_id{0};
-  std::uint64_t redirect_sse_count{0};
-  std::chrono::steady_clock::time_point redirect_sse_start{};
+  HeaderView request_headers; // Last decoded block; views into its own arena
+  HpackEncoder encoder;
 
   // Resource management and timeouts
   std::chrono::steady_clock::time_point created_at{std::chrono::steady_clock::now()};
@@ -69,11 +56,21 @@ struct Http2Connection {
   bool has_write_backpressure{false};
   bool tls_handshake_offloaded{false};  // TLS handshake in thread pool
 
+  // Response status codes and first-byte latency are recorded here; the
+  // timestamp is the oldest request still waiting for response bytes.
+  ServerMetrics* metrics{nullptr};
+  std::chrono::steady_clock::time_point awaiting_first_byte{};
+
   // Session caching
   std::string cached_session_token;
   std::string cached_user_id;
   bool session_validated{false};
 
+  // Staged, queued and flow-blocked outbound bytes
+  [[nodiscard]] std::size_t pending_write_bytes() const {
+    return write_buf.size() + send_queue.bytes() + flow.buffered_bytes();
+  }
+
   struct StreamState {
     std::string path;
     std::string method;
@@ -111,6 +108,7 @@ struct Http2Connection {
 #include "spin/static_cache.h++"
 #include "spin/session_cache.h++"
 #include "spin/sse_broadcaster.h++"
+#include "spin/shared_state.h++"
 
 namespace neonsignal {
 
@@ -120,20 +118,16 @@ class ApiHandler;
 class MailService;
 class MailCookieStore;
 
-struct SSEResetPolicy {
-  enum class Mode { OnlyTime, OnlyCount, Both };
-  Mode mode{Mode::OnlyTime};
-  std::chrono::seconds max_age{std::chrono::seconds(45)};
-  std::uint64_t max_messages{200};
-};
-
 class Http2Listener {
 public:
+  // reactor_id 0 is the primary reactor: it owns process-wide timers (redirect
+  // probe, mail cookie cleanup) and startup work such as static cache preload.
   Http2Listener(EventLoop& loop, ThreadPool& pool, SSL_CTX* ssl_ctx,
-                ServerConfig config, const Router& router,
+                ServerConfig config, const Router& router, SharedState& shared,
                 std::atomic<std::uint64_t>& served_files,
                 std::atomic<std::uint64_t>& page_views,
-                std::atomic<std::uint64_t>& event_clients);
+                std::atomic<std::uint64_t>& event_clients,
+                std::size_t reactor_id = 0, std::size_t reactor_count = 1);
   ~Http2Listener();
 
   void start();
@@ -147,14 +141,17 @@ private:
   void handle_io_(const std::shared_ptr<Http2Connection>& conn,
                   std::uint32_t events);
   void close_connection_(int fd);
+  // Count a request against its virtual host (or "default")
+  void count_request_(const std::string& authority);
   void start_redirect_monitor_();
+  void start_sse_channels_();
+  [[nodiscard]] bool is_primary_() const { return reactor_id_ == 0; }
   void stop_redirect_monitor_();
   bool probe_redirect_service_();
 
   // New: Timeout and cleanup handlers
   void check_connection_timeouts_();
   void cleanup_expired_sessions_();
-  void flush_sse_batches_();
 
   // New: TLS handshake offloading
   void offload_tls_handshake_(std::shared_ptr<Http2Connection> conn);
@@ -169,26 +166,36 @@ private:
   std::atomic<std::uint64_t>& served_files_;
   std::atomic<std::uint64_t>& page_views_;
   std::atomic<std::uint64_t>& event_clients_;
+  std::size_t reactor_id_;
 
-  // New: Advanced resource management
+  // Per-reactor shards
   std::unique_ptr<ConnectionManager> conn_manager_;
-  std::unique_ptr<StaticFileCache> static_cache_;
-  std::unique_ptr<SessionCache> session_cache_;
   std::unique_ptr<SSEBroadcaster> sse_broadcaster_;
-  std::unique_ptr<Database> db_;
-  std::unique_ptr<MailService> mail_service_;
-  std::unique_ptr<MailCookieStore> mail_cookie_store_;
 
-  std::atomic<bool> redirect_service_ok_{false};
+  // Process-wide state (owned by Server, shared across reactors)
+  SharedState& shared_;
+  StaticCacheRegistry& static_caches_;
+  StaticFileCache& static_cache_; // default public root
+  SessionCache& session_cache_;
+  Database& db_;
+  MailService& mail_service_;
+  MailCookieStore& mail_cookie_store_;
+  std::atomic<bool>& redirect_service_ok_;
+  WebAuthnManager& auth_;
+  VHostResolver& vhost_resolver_;
+  ServerMetrics& metrics_;
+
+  // Per-reactor metric handles; only touched on this reactor's thread
+  Gauge& connections_gauge_;
+  Gauge& write_buffer_gauge_;
+  Counter& default_vhost_requests_;
+  std::unordered_map<std::string, Counter*> vhost_requests_; // by authority
+
   int redirect_probe_port_{9090};
   int redirect_timer_id_{-1};
   int timeout_timer_id_{-1};
   int mail_cookie_timer_id_{-1};
-  WebAuthnManager auth_;
   std::unique_ptr<ApiHandler> api_handler_;
-  VHostResolver vhost_resolver_;
-
-  SSEResetPolicy sse_policy_{SSEResetPolicy::Mode::OnlyTime, std::chrono::seconds(45), 200};
 };
 
 } // namespace neonsignal
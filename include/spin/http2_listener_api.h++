@@ -28,6 +28,8 @@ enum class ApiRoute {
   Cpu,
   Memory,
   RedirectService,
+  Metrics,
+  MetricsStream,
 };
 
 ApiRoute identify_api_route(std::string_view path);
@@ -2,16 +2,22 @@
 
 #include "spin/neonsignal.h++"
 #include "spin/router.h++"
+#include "spin/static_cache.h++"
 
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
 namespace neonsignal {
 
+struct Http2Connection;
+
 inline constexpr std::string_view kClientPreface =
     "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
 inline constexpr std::size_t kMaxHeaderLog = 256;
@@ -20,8 +26,39 @@ struct StaticResult {
   int status{500};
   std::string content_type{"text/plain; charset=utf-8"};
   std::vector<std::uint8_t> body;
+  // Set on cache hits: `body` stays empty and the pre-encoded frames are sent
+  // straight from the shared entry (possibly a compressed variant).
+  std::shared_ptr<const CachedFile> cached;
+  // Set for files too large to hold in memory: the body is read from disk
+  // chunk by chunk as the peer's flow-control window opens.
+  std::filesystem::path stream_file;
+  std::uint64_t stream_size{0};
+  // Served from `cache` without touching the disk
+  bool cache_hit{false};
+
+  [[nodiscard]] bool has_etag_match(std::string_view if_none_match) const {
+    return cached && status == 200 && cached->matches_etag(if_none_match);
+  }
+  // Body bytes for paths that need to rewrite or re-frame the payload.
+  [[nodiscard]] std::vector<std::uint8_t> copy_body() const {
+    if (cached) {
+      return cached->body();
+    }
+    if (!stream_file.empty()) {
+      std::vector<std::uint8_t> content(static_cast<std::size_t>(stream_size));
+      std::ifstream in(stream_file, std::ios::binary);
+      in.read(reinterpret_cast<char*>(content.data()),
+              static_cast<std::streamsize>(content.size()));
+      content.resize(static_cast<std::size_t>(in.gcount()));
+      return content;
+    }
+    return body;
+  }
 };
 
+// Files above this size are streamed when there is no cache to bound them.
+inline constexpr std::size_t kStreamFileBytes = 2 * 1024 * 1024;
+
 /**
  * Create a non-blocking TCP listen socket bound to the configured host/port.
  *
@@ -64,6 +101,39 @@ void encode_string(std::vector<std::uint8_t>& out, std::string_view str);
 void encode_literal_header_no_index(std::vector<std::uint8_t>& out,
                                     std::uint32_t name_index,
                                     std::string_view value);
+/**
+ * Append a 9-byte HTTP/2 frame header to an existing buffer.
+ *
+ * @param out Destination buffer to append to.
+ * @param length Payload length (24 bits).
+ * @param type Frame type byte.
+ * @param flags Frame flags bitmask.
+ * @param stream_id Stream identifier (highest bit is cleared).
+ */
+void append_frame_header(std::vector<std::uint8_t>& out, std::uint32_t length,
+                         std::uint8_t type, std::uint8_t flags, std::uint32_t stream_id);
+/**
+ * Append a body as DATA frames (16 KiB chunks, END_STREAM on the last one)
+ * directly into `out`. An empty body emits a single empty END_STREAM frame.
+ *
+ * @param out Destination buffer to append to.
+ * @param stream_id Target stream id.
+ * @param body Payload bytes.
+ */
+void append_data_frames(std::vector<std::uint8_t>& out, std::uint32_t stream_id,
+                        std::span<const std::uint8_t> body);
+/**
+ * HPACK-encode a response header block: :status, content-type (skipped when
+ * empty) and literal extra headers.
+ *
+ * @param block Header block buffer to append to.
+ * @param status HTTP status code.
+ * @param content_type Content-Type header value.
+ * @param extra_headers Additional header key/value pairs to emit.
+ */
+void encode_response_headers(
+    std::vector<std::uint8_t>& block, int status, std::string_view content_type,
+    const std::vector<std::pair<std::string, std::string>>& extra_headers);
 /**
  * @brief Build a raw HTTP/2 frame.
  *
@@ -110,23 +180,36 @@ std::vector<std::uint8_t> build_server_settings();
  * @return Encoded SETTINGS ACK frame.
  */
 std::vector<std::uint8_t> build_settings_ack();
+/**
+ * Append a HEADERS frame (END_HEADERS) to the connection's staging buffer,
+ * encoded with the connection's stateful HPACK encoder.
+ *
+ * @param conn Connection whose encoder and write buffer are used.
+ * @param stream_id Target stream id.
+ * @param status HTTP status code.
+ * @param content_type Content-Type header value (skipped when empty).
+ * @param extra_headers Additional header key/value pairs to emit.
+ */
+void append_headers_frame(Http2Connection& conn, std::uint32_t stream_id, int status,
+                          std::string_view content_type,
+                          const std::vector<std::pair<std::string, std::string>>& extra_headers);
 /**
  * Encode HEADERS/DATA frames for a full HTTP/2 response.
  *
- * @param out Buffer to append frames to.
+ * @param conn Connection to stage the frames on.
  * @param stream_id Target stream id.
  * @param status HTTP status code.
  * @param content_type Content-Type header value.
  * @param body Response body payload.
  */
-void build_response_frames(std::vector<std::uint8_t>& out,
+void build_response_frames(Http2Connection& conn,
                            std::uint32_t stream_id, int status,
                            std::string_view content_type,
                            const std::vector<std::uint8_t>& body);
 /**
  * Encode HEADERS/DATA frames for a response with extra headers (e.g., cookies).
  *
- * @param out Buffer to append frames to.
+ * @param conn Connection to stage the frames on.
  * @param stream_id Target stream id.
  * @param status HTTP status code.
  * @param content_type Content-Type header value.
@@ -134,7 +217,7 @@ void build_response_frames(std::vector<std::uint8_t>& out,
  * @param body Response body payload.
  */
 void build_response_frames_with_headers(
-    std::vector<std::uint8_t>& out, std::uint32_t stream_id, int status,
+    Http2Connection& conn, std::uint32_t stream_id, int status,
     std::string_view content_type,
     const std::vector<std::pair<std::string, std::string>>& extra_headers,
     const std::vector<std::uint8_t>& body);
@@ -147,32 +230,38 @@ void build_response_frames_with_headers(
  */
 std::vector<std::uint8_t> build_window_update(std::uint32_t stream_id,
                                               std::uint32_t increment);
-// Forward declaration for cache
-class StaticFileCache;
-
 /**
  * Resolve and load a static asset from the router/public root.
- * Checks in-memory cache first, falls back to disk on cache miss.
+ * Checks in-memory cache first, falls back to disk on cache miss and stores
+ * the file in the cache when it fits.
  *
- * @param path HTTP path (leading slash).
+ * @param path HTTP path (leading slash, query string ignored).
  * @param router Router abstraction that maps paths to files.
  * @param cache Optional cache for in-memory file serving (nullptr = no cache).
- * @return StaticResult with status/content-type/body.
+ * @param accepted Content codings the client accepts (from accept-encoding);
+ *        cached hits may return a compressed variant.
+ * @return StaticResult with status/content-type and one of body, cached or
+ *         stream_file.
  */
 StaticResult load_static(std::string_view path, const Router& router,
-                         StaticFileCache* cache = nullptr);
+                         StaticFileCache* cache = nullptr,
+                         EncodingMask accepted = kIdentityOnly);
 
 /**
  * Resolve and load a static asset from a custom document root (for vhosting).
- * Does NOT use cache (vhost paths vary by domain).
+ * Uses the cache dedicated to that document root.
  *
- * @param path HTTP path (leading slash).
+ * @param path HTTP path (leading slash, query string ignored).
  * @param document_root Custom root directory for this virtual host.
  * @param router Router abstraction (uses its resolve(path, doc_root) overload).
- * @return StaticResult with status/content-type/body.
+ * @param cache Optional cache for this document root (nullptr = no cache).
+ * @param accepted Content codings the client accepts (from accept-encoding).
+ * @return StaticResult with status/content-type and one of body, cached or
+ *         stream_file.
  */
 StaticResult load_static_vhost(std::string_view path,
                                const std::filesystem::path& document_root,
-                               const Router& router);
+                               const Router& router, StaticFileCache* cache = nullptr,
+                               EncodingMask accepted = kIdentityOnly);
 
 } // namespace neonsignal
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace neonsignal {
+
+// Counters and histograms are split into this many cache-line-sized shards.
+inline constexpr std::size_t kMetricShards = 16;
+
+// Shard owned by the calling thread (assigned round-robin on first use).
+std::size_t metric_shard();
+
+/**
+ * Monotonic counter. add() is a relaxed fetch_add on the calling thread's
+ * shard, so reactors and pool workers never bounce the same cache line;
+ * value() sums the shards.
+ */
+class Counter {
+public:
+  void add(std::uint64_t n = 1) {
+    shards_[metric_shard()].value.fetch_add(n, std::memory_order_relaxed);
+  }
+  [[nodiscard]] std::uint64_t value() const;
+
+private:
+  struct alignas(64) Shard {
+    std::atomic<std::uint64_t> value{0};
+  };
+  std::array<Shard, kMetricShards> shards_{};
+};
+
+// Point-in-time value, written by whoever samples it.
+class Gauge {
+public:
+  void set(std::int64_t value) { value_.store(value, std::memory_order_relaxed); }
+  void add(std::int64_t delta) { value_.fetch_add(delta, std::memory_order_relaxed); }
+  [[nodiscard]] std::int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<std::int64_t> value_{0};
+};
+
+/**
+ * Log-linear (HDR-style) latency histogram in microseconds.
+ *
+ * Values below 8 µs get a bucket each; above that every power of two is split
+ * into 8 linear sub-buckets, so any recorded value is within 12.5% of its
+ * bucket's lower bound. The range tops out at 2^36 µs (about 19 hours).
+ * Recording is two relaxed adds on the calling thread's shard.
+ */
+class Histogram {
+public:
+  static constexpr unsigned kSubBucketBits = 3;
+  static constexpr unsigned kSubBuckets = 1u << kSubBucketBits;
+  static constexpr unsigned kMaxExponent = 35;
+  static constexpr std::size_t kBucketCount = (kMaxExponent - 1) * kSubBuckets;
+
+  struct Snapshot {
+    std::uint64_t count{0};
+    std::uint64_t sum_us{0};
+    std::array<std::uint64_t, kBucketCount> buckets{};
+
+    // Lower bound of the bucket holding quantile `q` (0..1)
+    [[nodiscard]] std::uint64_t percentile(double q) const;
+    [[nodiscard]] std::uint64_t max() const;
+  };
+
+  void record(std::uint64_t us) {
+    auto& shard = shards_[metric_shard()];
+    shard.buckets[bucket_index(us)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum_us.fetch_add(us, std::memory_order_relaxed);
+  }
+  void record(std::chrono::steady_clock::duration elapsed) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    record(us > 0 ? static_cast<std::uint64_t>(us) : 0);
+  }
+
+  [[nodiscard]] Snapshot snapshot() const;
+
+  [[nodiscard]] static std::size_t bucket_index(std::uint64_t us);
+  [[nodiscard]] static std::uint64_t bucket_lower_bound(std::size_t index);
+
+private:
+  struct alignas(64) Shard {
+    std::array<std::atomic<std::uint64_t>, kBucketCount> buckets{};
+    std::atomic<std::uint64_t> sum_us{0};
+  };
+  std::array<Shard, kMetricShards> shards_{};
+};
+
+/**
+ * Owns every instrument and renders them.
+ *
+ * Registration takes a mutex and is meant for startup or the first use of a
+ * label value; callers keep the returned reference, which stays valid for
+ * the registry's lifetime. `labels` is a pre-rendered Prometheus label list
+ * without braces (see label()).
+ */
+class MetricsRegistry {
+public:
+  Counter& counter(std::string_view name, std::string_view help, std::string_view labels = {});
+  Gauge& gauge(std::string_view name, std::string_view help, std::string_view labels = {});
+  Histogram& histogram(std::string_view name, std::string_view help,
+                       std::string_view labels = {});
+
+  // Prometheus text exposition format 0.0.4; histograms are in seconds with
+  // power-of-two bucket bounds.
+  [[nodiscard]] std::string prometheus_text() const;
+  // Compact JSON for the SSE channel: counter and gauge values, histogram
+  // count and p50/p90/p99/max in microseconds.
+  [[nodiscard]] std::string json() const;
+
+  // `key="value"` with the value escaped for the exposition format
+  [[nodiscard]] static std::string label(std::string_view key, std::string_view value);
+
+private:
+  enum class Type { Counter, Gauge, Histogram };
+
+  struct Series {
+    std::string labels;
+    void* instrument{nullptr};
+  };
+
+  struct Family {
+    Type type{Type::Counter};
+    std::string help;
+    std::vector<Series> series;
+  };
+
+  void* find_or_add_(Type type, std::string_view name, std::string_view help,
+                     std::string_view labels);
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Family, std::less<>> families_; // sorted output
+  // Stable storage; instruments are never removed
+  std::deque<Counter> counters_;
+  std::deque<Gauge> gauges_;
+  std::deque<Histogram> histograms_;
+};
+
+/**
+ * The server's instruments, resolved once so hot paths only touch atomics.
+ * Shared by every reactor and the worker pool.
+ */
+struct ServerMetrics {
+  explicit ServerMetrics(MetricsRegistry& registry);
+
+  ServerMetrics(const ServerMetrics&) = delete;
+  ServerMetrics& operator=(const ServerMetrics&) = delete;
+
+  MetricsRegistry& registry;
+
+  Histogram& tls_handshake;    // accept -> handshake complete
+  Counter& tls_full_handshakes;
+  Counter& tls_resumed_handshakes; // session ticket or cache hit
+  Counter& ktls_connections;       // handshakes that left record encryption to the kernel
+  Histogram& first_byte;       // request HEADERS -> first response bytes on the socket
+  Histogram& pool_task_wait;   // ThreadPool enqueue -> worker pickup
+  Gauge& pool_queue_depth;
+  Counter& static_cache_hits;
+  Counter& static_cache_misses;
+  Counter& session_cache_hits;
+  Counter& session_cache_misses;
+  Gauge& log_lines_dropped;
+
+  void count_status(int status) {
+    auto* counter = (status >= 100 && status < 600) ? status_[status - 100] : nullptr;
+    (counter ? counter : status_other_)->add();
+  }
+  // Requests per virtual host; resolves (and may register) the series, so
+  // callers cache the result.
+  Counter& vhost_requests(std::string_view vhost);
+  // Per-reactor connection gauges
+  Gauge& connections(std::size_t reactor_id);
+  Gauge& write_buffer_bytes(std::size_t reactor_id);
+
+private:
+  std::array<Counter*, 500> status_{}; // by status - 100, common codes only
+  Counter* status_other_;
+};
+
+} // namespace neonsignal
@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <openssl/ssl.h>
 
@@ -16,6 +18,7 @@ class ThreadPool;
 class Http2Listener;
 class Router;
 class CertManager;
+struct SharedState;
 
 struct ServerConfig {
   std::string host = "0.0.0.0";
@@ -47,10 +50,15 @@ private:
   ServerConfig config_;
   std::unique_ptr<CertManager> cert_manager_;
   std::unique_ptr<SSL_CTX, SSLContextDeleter> ssl_ctx_;
-  std::unique_ptr<EventLoop> loop_;
-  std::unique_ptr<ThreadPool> pool_;
-  std::unique_ptr<Http2Listener> listener_;
+  // Declared before pool_ so background tasks never outlive the caches.
+  std::unique_ptr<SharedState> shared_;
   std::unique_ptr<Router> router_;
+  // One EventLoop + Http2Listener per reactor; index 0 runs on the calling thread.
+  std::vector<std::unique_ptr<EventLoop>> loops_;
+  std::vector<std::unique_ptr<Http2Listener>> listeners_;
+  // Destroyed (joined) first: database tasks post completions to the loops.
+  std::unique_ptr<ThreadPool> pool_;
+  std::vector<std::thread> reactor_threads_;
   std::atomic<std::uint64_t> served_files_{0};
   std::atomic<std::uint64_t> page_views_{0};
   std::atomic<std::uint64_t> event_clients_{0};
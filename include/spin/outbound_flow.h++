@@ -0,0 +1,114 @@
+#pragma once
+
+#include "spin/write_queue.h++"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace neonsignal {
+
+/**
+ * Server-side HTTP/2 send scheduling for one connection (RFC 9113 §5.2, §6.9).
+ *
+ * Handlers keep appending complete frames to the connection's staging buffer.
+ * At flush time stage() moves that buffer into the WriteQueue: control frames
+ * pass straight through in order, while DATA payloads are parked per stream as
+ * zero-copy slices. pump() then emits DATA round-robin across streams, one
+ * frame per stream per round, within the peer's connection and stream windows
+ * and its SETTINGS_MAX_FRAME_SIZE. Large files are read from disk in
+ * window-sized chunks instead of being loaded up front, or, once
+ * enable_sendfile() is called on a kernel TLS connection, not read at all:
+ * their DATA frames reference the file and go out with SSL_sendfile().
+ */
+class OutboundFlow {
+public:
+  using Buffer = WriteQueue::Buffer;
+
+  static constexpr std::int64_t kDefaultWindow = 65'535;
+  static constexpr std::int64_t kMaxWindow = 0x7FFF'FFFF;
+  static constexpr std::uint32_t kDefaultMaxFrame = 16'384;
+  static constexpr std::size_t kFileChunkBytes = 64 * 1024;
+
+  // Route staged frames into `queue`; `frames` is left empty.
+  void stage(std::vector<std::uint8_t>& frames, WriteQueue& queue);
+  // Queue a DATA payload for `stream_id` (a slice of a shared buffer).
+  void push_data(std::uint32_t stream_id, Buffer buffer, std::size_t offset,
+                 std::size_t length, bool end_stream);
+  // Stream the body of `file` (END_STREAM on the last chunk); false if the
+  // file cannot be opened.
+  [[nodiscard]] bool attach_file(std::uint32_t stream_id, const std::filesystem::path& file,
+                                 std::uint64_t size);
+
+  // Queue file bodies as file ranges for SSL_sendfile(); only call once the
+  // connection's kernel TLS send path is active.
+  void enable_sendfile() { sendfile_ = true; }
+
+  // Peer SETTINGS payload; false on a protocol or flow-control error.
+  [[nodiscard]] bool on_settings(const std::vector<std::uint8_t>& payload);
+  // Peer WINDOW_UPDATE; false on a connection-level error.
+  [[nodiscard]] bool on_window_update(std::uint32_t stream_id, std::uint32_t increment);
+  // Peer RST_STREAM: drop everything still queued for the stream.
+  void close_stream(std::uint32_t stream_id);
+
+  // Move DATA into `queue` until it holds `budget` bytes or every stream is
+  // blocked on flow control.
+  void pump(WriteQueue& queue, std::size_t budget);
+  // True when pump() would make progress.
+  [[nodiscard]] bool has_sendable() const;
+  // DATA bytes held in memory awaiting window (file bodies not yet read are
+  // not counted).
+  [[nodiscard]] std::size_t buffered_bytes() const { return buffered_bytes_; }
+
+private:
+  struct Chunk {
+    Buffer buffer;
+    std::size_t offset{0};
+    std::size_t length{0};
+    bool end_stream{false};
+    WriteQueue::FileRef file; // sendfile: payload is `length` bytes at file_offset
+    std::uint64_t file_offset{0};
+  };
+
+  struct FileBody {
+    WriteQueue::FileRef file;
+    std::uint64_t offset{0};
+    std::uint64_t remaining{0};
+  };
+
+  struct Stream {
+    std::int64_t window{kDefaultWindow};
+    std::deque<Chunk> chunks;
+    std::unique_ptr<FileBody> file;
+  };
+
+  // Creates the stream on first use, applying any credit granted before it.
+  Stream& stream_(std::uint32_t stream_id);
+  // Remember a reset or finished stream so late writes and credit are ignored.
+  void mark_closed_(std::uint32_t stream_id);
+  [[nodiscard]] bool can_send_(const Stream& stream) const;
+  // Read the next file chunk once the previous one is queued; false on a
+  // read error.
+  [[nodiscard]] bool refill_(Stream& stream);
+  // Emit one DATA frame for the stream; returns true if the stream finished.
+  bool emit_frame_(std::uint32_t stream_id, Stream& stream, WriteQueue& queue);
+
+  std::map<std::uint32_t, Stream> streams_;
+  std::unordered_set<std::uint32_t> closed_streams_;
+  // WINDOW_UPDATE credit for open streams whose response is not queued yet
+  std::unordered_map<std::uint32_t, std::int64_t> pending_credit_;
+  std::uint32_t next_stream_{0}; // round-robin cursor
+  std::int64_t connection_window_{kDefaultWindow};
+  std::int64_t peer_initial_window_{kDefaultWindow};
+  std::uint32_t peer_max_frame_{kDefaultMaxFrame};
+  std::size_t buffered_bytes_{0};
+  bool sendfile_{false};
+};
+
+} // namespace neonsignal
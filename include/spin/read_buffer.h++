@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace neonsignal {
+
+/**
+ * Inbound byte buffer for a connection.
+ *
+ * Consumed bytes only advance a head offset, so parsing a frame is O(1)
+ * instead of erasing from the front of a vector. Unread bytes stay
+ * contiguous for the frame parser; they are slid back to the front only when
+ * the tail runs out of room, which keeps the total copying amortized O(1)
+ * per byte.
+ */
+class ReadBuffer {
+public:
+  [[nodiscard]] std::size_t size() const { return end_ - begin_; }
+  [[nodiscard]] bool empty() const { return begin_ == end_; }
+  [[nodiscard]] const std::uint8_t* data() const { return buf_.data() + begin_; }
+  [[nodiscard]] std::uint8_t operator[](std::size_t i) const { return buf_[begin_ + i]; }
+
+  // Writable tail with room for at least `n` bytes; follow with commit().
+  [[nodiscard]] std::uint8_t* prepare(std::size_t n) {
+    if (buf_.size() - end_ < n) {
+      if (begin_ > 0) {
+        std::memmove(buf_.data(), buf_.data() + begin_, size());
+        end_ -= begin_;
+        begin_ = 0;
+      }
+      if (buf_.size() - end_ < n) {
+        buf_.resize(std::max(end_ + n, buf_.size() * 2));
+      }
+    }
+    return buf_.data() + end_;
+  }
+
+  void commit(std::size_t n) { end_ += n; }
+
+  void append(const std::uint8_t* bytes, std::size_t n) {
+    std::memcpy(prepare(n), bytes, n);
+    commit(n);
+  }
+
+  void consume(std::size_t n) {
+    begin_ += std::min(n, size());
+    if (begin_ == end_) {
+      begin_ = end_ = 0;
+    }
+  }
+
+  void clear() { begin_ = end_ = 0; }
+
+private:
+  std::vector<std::uint8_t> buf_;
+  std::size_t begin_{0};
+  std::size_t end_{0};
+};
+
+} // namespace neonsignal
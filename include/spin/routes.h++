@@ -41,9 +41,11 @@ constexpr std::string_view kEvents = "/api/events";
 constexpr std::string_view kCpu = "/api/cpu";
 constexpr std::string_view kMemory = "/api/memory";
 constexpr std::string_view kRedirectService = "/api/redirect_service";
+constexpr std::string_view kMetrics = "/api/metrics";
+constexpr std::string_view kMetricsStream = "/api/metrics/stream";
 } // namespace api
 
-constexpr std::array<std::string_view, 19> kProtectedPaths = {
+constexpr std::array<std::string_view, 21> kProtectedPaths = {
     pages::kData,
     pages::kDataHtml,
     pages::kCodex,
@@ -53,6 +55,8 @@ constexpr std::array<std::string_view, 19> kProtectedPaths = {
     api::kCpu,
     api::kMemory,
     api::kRedirectService,
+    api::kMetrics,
+    api::kMetricsStream,
     api::kAuthUserCheck,
     api::kCodexBrief,
     api::kCodexList,
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <shared_mutex>
+
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+
+namespace neonsignal {
+
+/**
+ * Session ticket encryption keys shared by every SSL_CTX (RFC 5077 / RFC 8446
+ * §4.6.1 tickets), so a ticket issued under one virtual host's context is
+ * accepted after SNI switches to another and survives CertManager::reload().
+ *
+ * The current key seals new tickets; the previous kKeyCount - 1 keys still
+ * open old ones, and a ticket opened with a retired key is re-issued under
+ * the current one. Keys rotate lazily every kRotateInterval, from whichever
+ * handshake first notices, which bounds how long a leaked key can decrypt
+ * recorded sessions.
+ */
+class SessionTicketKeys {
+public:
+  static constexpr std::chrono::seconds kRotateInterval{3600};
+  static constexpr std::size_t kKeyCount = 3;
+  // A ticket stays decryptable for at least this long after it was issued.
+  static constexpr std::chrono::seconds kTicketLifetime = kRotateInterval * (kKeyCount - 1);
+
+  SessionTicketKeys();
+
+  SessionTicketKeys(const SessionTicketKeys&) = delete;
+  SessionTicketKeys& operator=(const SessionTicketKeys&) = delete;
+
+  // Route `ctx`'s ticket encryption through these keys.
+  void install(SSL_CTX* ctx);
+  // Start a fresh current key now; the oldest key is forgotten.
+  void rotate();
+
+private:
+  struct Key {
+    std::array<unsigned char, 16> name{};
+    std::array<unsigned char, 32> aes{};
+    std::array<unsigned char, 32> hmac{};
+  };
+
+  static int ticket_callback_(SSL* ssl, unsigned char* key_name, unsigned char* iv,
+                              EVP_CIPHER_CTX* cipher, EVP_MAC_CTX* mac, int encrypt);
+  int seal_or_open_(unsigned char* key_name, unsigned char* iv, EVP_CIPHER_CTX* cipher,
+                    EVP_MAC_CTX* mac, bool encrypt);
+  void rotate_locked_();
+
+  mutable std::shared_mutex mutex_;
+  std::array<Key, kKeyCount> keys_{};
+  std::size_t current_{0};
+  std::chrono::steady_clock::time_point rotated_at_{};
+};
+
+} // namespace neonsignal
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "spin/neonsignal.h++"
+#include "spin/database.h++"
+#include "spin/mail_cookie_store.h++"
+#include "spin/mail_service.h++"
+#include "spin/metrics.h++"
+#include "spin/session_cache.h++"
+#include "spin/static_cache.h++"
+#include "spin/vhost.h++"
+#include "spin/webauthn.h++"
+
+#include <atomic>
+#include <memory>
+
+namespace neonsignal {
+
+/**
+ * Process-wide state shared by every reactor (EventLoop + Http2Listener pair).
+ * Each member is either internally synchronized or only mutated at startup,
+ * so reactors can use it concurrently without further locking.
+ */
+struct SharedState {
+  explicit SharedState(ServerConfig server_config);
+
+  SharedState(const SharedState&) = delete;
+  SharedState& operator=(const SharedState&) = delete;
+  SharedState(SharedState&&) = delete;
+  SharedState& operator=(SharedState&&) = delete;
+
+  // Owned copy so MailService/MailCookieStore can hold stable references.
+  ServerConfig config;
+
+  // One static cache per document root, invalidated through inotify
+  std::unique_ptr<StaticCacheRegistry> static_caches;
+  std::unique_ptr<SessionCache> session_cache;
+  std::unique_ptr<Database> db;
+  std::unique_ptr<MailService> mail_service;
+  std::unique_ptr<MailCookieStore> mail_cookie_store;
+  WebAuthnManager auth;
+  VHostResolver vhost_resolver;
+
+  // Written by the primary reactor's probe timer, read by all reactors.
+  std::atomic<bool> redirect_service_ok{false};
+
+  // Rendered by /api/metrics; `metrics` holds the pre-resolved instruments.
+  MetricsRegistry metrics_registry;
+  ServerMetrics metrics{metrics_registry};
+};
+
+} // namespace neonsignal
@@ -1,23 +1,46 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 namespace neonsignal {
 
 struct Http2Connection;
+class EventLoop;
 
 /**
- * Optimized SSE (Server-Sent Events) broadcaster
- * Batches events and pre-encodes HTTP/2 DATA frames for efficiency
+ * Lifetime limit for SSE streams. Browsers reconnect on their own, so ending
+ * streams periodically keeps long-lived dashboards from pinning a stream
+ * forever.
+ */
+struct SSEResetPolicy {
+  enum class Mode { OnlyTime, OnlyCount, Both };
+  Mode mode{Mode::OnlyTime};
+  std::chrono::seconds max_age{std::chrono::seconds(45)};
+  std::uint64_t max_messages{200};
+};
+
+/**
+ * Timer-driven SSE fan-out for one reactor.
+ *
+ * Every channel has a producer and a tick interval. On each tick the payload
+ * is computed once and encoded once as a DATA frame with a zero stream id;
+ * delivering it to a subscriber is an append plus patching the stream id.
+ * Subscribers whose connection is backed up are skipped: Drop channels lose
+ * that sample, Coalesce channels keep only the newest frame and deliver it
+ * once the connection drains. The reset policy is checked for every
+ * subscriber on every tick; when it limits age, a sweep every kResetSweep
+ * also ends streams of channels that tick less often than max_age.
  */
 class SSEBroadcaster {
 public:
@@ -25,194 +48,99 @@ public:
     Events,       // General application events
     CPUMetrics,   // CPU usage stats
     MemMetrics,   // Memory usage stats
-    Redirect      // Redirect service status
+    Redirect,     // Redirect service status
+    Metrics       // MetricsRegistry snapshot
   };
+  static constexpr std::size_t kChannelCount = 5;
+
+  enum class Backpressure { Drop, Coalesce };
+
+  struct ChannelConfig {
+    std::chrono::milliseconds interval{1000};
+    Backpressure backpressure{Backpressure::Coalesce};
+    // Skip ticks whose payload equals the last one; a heartbeat still goes
+    // out every kHeartbeat.
+    bool skip_unchanged{false};
+  };
+
+  // Produces one SSE event ("data: ...\n\n")
+  using Producer = std::function<std::string()>;
 
-  // Batch interval - accumulate events for this duration
-  static constexpr std::chrono::milliseconds BATCH_INTERVAL{16};  // ~60fps
-
-  SSEBroadcaster() = default;
-
-  // Subscribe connection to a channel
-  void subscribe(Channel channel, int fd, std::shared_ptr<Http2Connection> conn,
-                 std::uint32_t stream_id) {
-    std::lock_guard lock(mutex_);
-    Subscription sub{fd, std::move(conn), stream_id};
-    subscriptions_[channel].insert(sub);
-  }
-
-  // Unsubscribe connection from channel
-  void unsubscribe(Channel channel, int fd) {
-    std::lock_guard lock(mutex_);
-    auto& subs = subscriptions_[channel];
-    std::erase_if(subs, [fd](const Subscription& sub) {
-      return sub.fd == fd;
-    });
-  }
-
-  // Unsubscribe from all channels
-  void unsubscribe_all(int fd) {
-    std::lock_guard lock(mutex_);
-    for (auto& [_, subs] : subscriptions_) {
-      std::erase_if(subs, [fd](const Subscription& sub) {
-        return sub.fd == fd;
-      });
-    }
-  }
-
-  // Queue an event for broadcast (batched)
-  void queue_event(Channel channel, std::string_view event_data) {
-    std::lock_guard lock(mutex_);
-    pending_events_[channel].emplace_back(event_data);
-  }
-
-  // Immediate broadcast (bypasses batching)
-  void broadcast_immediate(Channel channel, std::string_view event_data,
-                          std::function<void(const std::shared_ptr<Http2Connection>&,
-                                             std::uint32_t, const std::vector<std::uint8_t>&)> send_frame) {
-    auto frame = encode_sse_data_frame_(event_data);
-
-    std::lock_guard lock(mutex_);
-    auto it = subscriptions_.find(channel);
-    if (it == subscriptions_.end()) return;
-
-    for (const auto& sub : it->second) {
-      if (auto conn = sub.conn.lock()) {
-        send_frame(conn, sub.stream_id, frame);
-      }
-    }
-  }
-
-  // Flush batched events (call periodically, e.g., every 16ms)
-  void flush_batched(std::function<void(const std::shared_ptr<Http2Connection>&,
-                                        std::uint32_t, const std::vector<std::uint8_t>&)> send_frame) {
-    std::unordered_map<Channel, std::vector<std::string>> events_snapshot;
-
-    {
-      std::lock_guard lock(mutex_);
-      events_snapshot = std::move(pending_events_);
-      pending_events_.clear();
-    }
-
-    // Process each channel
-    for (const auto& [channel, events] : events_snapshot) {
-      if (events.empty()) continue;
-
-      // Combine multiple events into a single frame (if small enough)
-      std::string combined;
-      for (const auto& event : events) {
-        combined += event;
-        combined += "\n\n";  // SSE event separator
-      }
-
-      // Pre-encode once for all subscribers
-      auto frame = encode_sse_data_frame_(combined);
-
-      // Broadcast to all subscribers of this channel
-      std::lock_guard lock(mutex_);
-      auto it = subscriptions_.find(channel);
-      if (it == subscriptions_.end()) continue;
-
-      for (const auto& sub : it->second) {
-        if (auto conn = sub.conn.lock()) {
-          send_frame(conn, sub.stream_id, frame);
-        }
-      }
-    }
-  }
-
-  // Get subscriber count for a channel
-  [[nodiscard]] std::size_t subscriber_count(Channel channel) const {
-    std::lock_guard lock(mutex_);
-    auto it = subscriptions_.find(channel);
-    return (it != subscriptions_.end()) ? it->second.size() : 0;
-  }
-
-  // Get total subscriber count
-  [[nodiscard]] std::size_t total_subscribers() const {
-    std::lock_guard lock(mutex_);
-    std::size_t total = 0;
-    for (const auto& [_, subs] : subscriptions_) {
-      total += subs.size();
-    }
-    return total;
-  }
-
-  // Simple iteration over subscribers (for custom frame building)
-  template<typename Callback>
-  void for_each_subscriber(Channel channel, Callback&& callback) {
-    std::lock_guard lock(mutex_);
-    auto it = subscriptions_.find(channel);
-    if (it == subscriptions_.end()) return;
-
-    // Iterate and call callback for each active subscriber
-    for (const auto& sub : it->second) {
-      if (auto conn = sub.conn.lock()) {
-        callback(conn, sub.stream_id);
-      }
-    }
-  }
+  static constexpr std::chrono::seconds kHeartbeat{15};
+  // Granularity of max_age enforcement between channel ticks
+  static constexpr std::chrono::seconds kResetSweep{1};
+
+  SSEBroadcaster(EventLoop& loop, SSEResetPolicy policy, std::size_t max_pending_bytes,
+                 std::atomic<std::uint64_t>& event_clients);
+  ~SSEBroadcaster();
+
+  SSEBroadcaster(const SSEBroadcaster&) = delete;
+  SSEBroadcaster& operator=(const SSEBroadcaster&) = delete;
+
+  // Configure a channel before start()
+  void set_channel(Channel channel, ChannelConfig config, Producer producer);
+  // Arm one timer per configured channel
+  void start();
+  void stop();
+
+  // Register a stream whose HEADERS are already staged; the channel's latest
+  // event is sent right away.
+  void subscribe(Channel channel, const std::shared_ptr<Http2Connection>& conn,
+                 std::uint32_t stream_id);
+  // Peer reset the stream
+  void unsubscribe_stream(int fd, std::uint32_t stream_id);
+  // Connection closed
+  void unsubscribe_all(int fd);
+  // The connection's send queue drained: deliver coalesced frames
+  void on_drained(const std::shared_ptr<Http2Connection>& conn);
+
+  [[nodiscard]] std::size_t subscriber_count(Channel channel) const;
+  [[nodiscard]] std::size_t total_subscribers() const;
 
 private:
-  struct Subscription {
-    int fd;
-    std::weak_ptr<Http2Connection> conn;
-    std::uint32_t stream_id;
+  using Frame = std::shared_ptr<const std::vector<std::uint8_t>>;
 
-    bool operator==(const Subscription& other) const {
-      return fd == other.fd && stream_id == other.stream_id;
-    }
+  struct Subscriber {
+    std::weak_ptr<Http2Connection> conn;
+    std::uint32_t stream_id{0};
+    std::chrono::steady_clock::time_point started{};
+    std::uint64_t sent{0};
+    Frame pending; // newest frame held back by backpressure (Coalesce)
   };
 
-  struct SubscriptionHash {
-    std::size_t operator()(const Subscription& sub) const {
-      return std::hash<int>{}(sub.fd) ^ (std::hash<std::uint32_t>{}(sub.stream_id) << 1);
-    }
+  struct ChannelState {
+    ChannelConfig config;
+    Producer producer;
+    int timer_id{-1};
+    std::string last_payload;
+    Frame last_frame;
+    std::chrono::steady_clock::time_point last_published{};
+    std::unordered_map<int, std::vector<Subscriber>> subscribers; // by fd
   };
 
-  // Encode SSE data as HTTP/2 DATA frame
-  [[nodiscard]] std::vector<std::uint8_t> encode_sse_data_frame_(std::string_view data) const {
-    // HTTP/2 DATA frame format:
-    // +-----------------------------------------------+
-    // |                 Length (24)                   |
-    // +---------------+---------------+---------------+
-    // |   Type (8)    |   Flags (8)   |
-    // +-+-------------+---------------+-------------------------------+
-    // |R|                 Stream Identifier (31)                      |
-    // +=+=============================================================+
-    // |                   Data (*)                   ...
-    // +---------------------------------------------------------------+
-
-    std::vector<std::uint8_t> frame;
-    frame.reserve(9 + data.size());
-
-    // Length (24 bits)
-    std::uint32_t length = static_cast<std::uint32_t>(data.size());
-    frame.push_back((length >> 16) & 0xFF);
-    frame.push_back((length >> 8) & 0xFF);
-    frame.push_back(length & 0xFF);
-
-    // Type: DATA (0x00)
-    frame.push_back(0x00);
-
-    // Flags: None (stream stays open)
-    frame.push_back(0x00);
-
-    // Stream ID will be filled by caller (4 bytes placeholder)
-    frame.push_back(0x00);
-    frame.push_back(0x00);
-    frame.push_back(0x00);
-    frame.push_back(0x00);
-
-    // Data payload
-    frame.insert(frame.end(), data.begin(), data.end());
-
-    return frame;
-  }
+  void tick_(Channel channel);
+  // End every stream the reset policy has expired, on any channel
+  void sweep_resets_();
+  // Run the producer and encode its payload (lock held)
+  void publish_(ChannelState& state, std::chrono::steady_clock::time_point now);
+  void deliver_(Http2Connection& conn, Subscriber& sub, const std::vector<std::uint8_t>& frame);
+  void end_stream_(Http2Connection& conn, std::uint32_t stream_id);
+  [[nodiscard]] bool should_reset_(const Subscriber& sub,
+                                   std::chrono::steady_clock::time_point now) const;
+  [[nodiscard]] bool backpressured_(const Http2Connection& conn) const;
+  void released_(Channel channel, std::size_t count);
+  [[nodiscard]] static Frame encode_frame_(std::string_view payload);
+
+  ChannelState& state_(Channel channel) { return channels_[static_cast<std::size_t>(channel)]; }
+
+  EventLoop& loop_;
+  SSEResetPolicy policy_;
+  std::size_t max_pending_bytes_;
+  std::atomic<std::uint64_t>& event_clients_;
 
   mutable std::mutex mutex_;
-  std::unordered_map<Channel, std::unordered_set<Subscription, SubscriptionHash>> subscriptions_;
-  std::unordered_map<Channel, std::vector<std::string>> pending_events_;
+  std::array<ChannelState, kChannelCount> channels_;
+  int reset_timer_id_{-1};
 };
 
 } // namespace neonsignal
@@ -1,196 +1,205 @@
 #pragma once
 
+#include "spin/compression.h++"
+#include "spin/outbound_flow.h++"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
-#include <fstream>
-#include <iostream>
+#include <functional>
+#include <list>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace neonsignal {
 
 /**
- * In-memory cache for frequently accessed static files
- * Eliminates blocking disk I/O on the event loop thread
+ * Immutable, pre-encoded static response.
+ *
+ * `frames` holds the complete 200 response (HEADERS + DATA frames) with the
+ * stream id left as zero. Serving a hit appends the HEADERS frame and queues
+ * the DATA payloads as zero-copy slices of `frames`. Entries are shared
+ * through `std::shared_ptr<const CachedFile>`, so an invalidation never pulls
+ * the bytes out from under a response that is still being written.
+ *
+ * Each content coding of a file is its own CachedFile (own body, own ETag);
+ * compressed variants carry content-encoding, and every variant of a
+ * compressible file carries `vary: accept-encoding`.
+ */
+struct CachedFile : std::enable_shared_from_this<CachedFile> {
+  std::filesystem::path source;
+  std::string mime_type;
+  std::string etag; // Strong validator derived from a SHA-256 of the body
+  ContentEncoding encoding{ContentEncoding::identity};
+  bool vary{false};
+  std::size_t body_size{0};
+  std::vector<std::uint8_t> frames;
+  std::vector<std::size_t> frame_offsets;
+  std::vector<std::uint8_t> not_modified; // 304 HEADERS frame (END_STREAM)
+
+  [[nodiscard]] static std::shared_ptr<const CachedFile>
+  make(std::filesystem::path source, std::string mime_type,
+       const std::vector<std::uint8_t>& content,
+       ContentEncoding encoding = ContentEncoding::identity, bool vary = false);
+
+  // Append the 200 HEADERS frame for `stream_id`; extra headers force a
+  // freshly encoded block.
+  void append_headers(std::vector<std::uint8_t>& out, std::uint32_t stream_id,
+                      const std::vector<std::pair<std::string, std::string>>& extra_headers = {})
+      const;
+  // Hand the body to the connection's send scheduler without copying it.
+  void queue_body(OutboundFlow& flow, std::uint32_t stream_id) const;
+  // Append the 304 Not Modified response for `stream_id`.
+  void append_not_modified(std::vector<std::uint8_t>& out, std::uint32_t stream_id) const;
+
+  // If-None-Match evaluation (weak comparison, RFC 9110 §13.1.2).
+  [[nodiscard]] bool matches_etag(std::string_view if_none_match) const;
+  // Reassemble the body from the DATA frames (slow paths only).
+  [[nodiscard]] std::vector<std::uint8_t> body() const;
+  [[nodiscard]] std::size_t memory_bytes() const { return frames.size() + not_modified.size(); }
+};
+
+/**
+ * In-memory cache for static files of a single document root.
+ * Eliminates blocking disk I/O on the event loop thread.
+ * Lookups and inserts are O(1); eviction drops the least recently used entry.
  */
 class StaticFileCache {
 public:
-  struct CachedFile {
-    std::vector<std::uint8_t> content;
-    std::string mime_type;
-    std::string etag;  // For cache validation
-    std::chrono::system_clock::time_point last_modified;
-    std::size_t access_count{0};
-  };
-
-  explicit StaticFileCache(std::size_t max_cache_size_bytes = 50 * 1024 * 1024)
-      : max_cache_size_bytes_(max_cache_size_bytes) {}
-
-  // Pre-load critical files at startup
-  void preload(const std::filesystem::path& public_root) {
-    // Critical files that should ALWAYS be in memory
-    const std::vector<std::string> critical_files = {
-        "index.html",
-        "app.js",
-        "app.css",
-        "favicon.ico"
-    };
-
-    for (const auto& file : critical_files) {
-      auto path = public_root / file;
-      if (std::filesystem::exists(path)) {
-        load_file(path, "/" + file);
-      }
-    }
-
-    // Scan and pre-load small files (< 100KB)
-    for (const auto& entry : std::filesystem::recursive_directory_iterator(public_root)) {
-      if (entry.is_regular_file() && entry.file_size() < 100 * 1024) {
-        auto rel_path = std::filesystem::relative(entry.path(), public_root);
-        load_file(entry.path(), "/" + rel_path.string());
-      }
-    }
-
-    std::cerr << std::format("• Static cache: {} files loaded, {} bytes\n",
-                             cache_.size(), current_size_bytes_);
-  }
-
-  // Get file from cache
-  [[nodiscard]] std::optional<CachedFile> get(std::string_view path) {
-    std::lock_guard lock(mutex_);
-    auto it = cache_.find(std::string(path));
-    if (it != cache_.end()) {
-      it->second.access_count++;
-      return it->second;
+  // Invoked with the parent directory of every file about to be cached so
+  // the owner can start watching it for changes.
+  using WatchHook = std::function<void(const std::filesystem::path&)>;
+  // Runs background work (compression) off the event loop.
+  using Executor = std::function<void(std::function<void()>)>;
+
+  explicit StaticFileCache(std::size_t max_cache_size_bytes = 50 * 1024 * 1024,
+                           std::size_t max_entry_bytes = 2 * 1024 * 1024);
+
+  void set_watch_hook(WatchHook hook) { watch_hook_ = std::move(hook); }
+  // Watch the directory holding `source`. Call it before reading the file
+  // for put(), so a write that races the read still invalidates the entry.
+  void watch(const std::filesystem::path& source) const {
+    if (watch_hook_) {
+      watch_hook_(source.lexically_normal().parent_path());
     }
-    return std::nullopt;
   }
+  // Without an executor, missing compressed variants are built inline.
+  void set_executor(Executor executor) { executor_ = std::move(executor); }
 
-  // Manually add file to cache
-  void put(std::string_view path, std::vector<std::uint8_t> content,
-           std::string_view mime_type) {
-    std::lock_guard lock(mutex_);
-
-    // Evict if over size limit
-    while (current_size_bytes_ + content.size() > max_cache_size_bytes_ &&
-           !cache_.empty()) {
-      evict_lru_();
-    }
-
-    CachedFile file;
-    file.content = std::move(content);
-    file.mime_type = mime_type;
-    file.etag = generate_etag_(file.content);
-    file.last_modified = std::chrono::system_clock::now();
-    file.access_count = 0;
-
-    current_size_bytes_ += file.content.size();
-    cache_[std::string(path)] = std::move(file);
-  }
-
-  // Check if file is in cache
-  [[nodiscard]] bool contains(std::string_view path) const {
-    std::lock_guard lock(mutex_);
-    return cache_.contains(std::string(path));
-  }
+  // Pre-load critical files at startup
+  void preload(const std::filesystem::path& public_root);
+
+  // Get the best variant the client accepts (refreshes its LRU position).
+  // Preference: br, zstd, gzip, identity.
+  [[nodiscard]] std::shared_ptr<const CachedFile> get(std::string_view path,
+                                                      EncodingMask accepted = kIdentityOnly);
+
+  // Add file to cache; returns the identity entry, or nullptr if it is too
+  // large. Variants of compressible types (sibling .br/.gz/.zst files, or
+  // compressed here when absent) are attached later from the executor.
+  std::shared_ptr<const CachedFile> put(std::string_view path,
+                                        const std::filesystem::path& source,
+                                        const std::vector<std::uint8_t>& content,
+                                        std::string mime_type);
+
+  // Drop every entry backed by `source`
+  void invalidate_file(const std::filesystem::path& source);
+  // Drop every entry whose source lives under `directory`
+  void invalidate_directory(const std::filesystem::path& directory);
 
   // Clear cache
-  void clear() {
-    std::lock_guard lock(mutex_);
-    cache_.clear();
-    current_size_bytes_ = 0;
-  }
+  void clear();
 
   // Statistics
   [[nodiscard]] std::size_t size() const {
     std::lock_guard lock(mutex_);
-    return cache_.size();
+    return entries_.size();
   }
 
   [[nodiscard]] std::size_t bytes() const {
+    std::lock_guard lock(mutex_);
     return current_size_bytes_;
   }
 
-private:
-  void load_file(const std::filesystem::path& file_path,
-                 const std::string& cache_key) {
-    try {
-      std::ifstream file(file_path, std::ios::binary);
-      if (!file) return;
+  // Memory held per content coding (frames of every cached variant)
+  [[nodiscard]] std::array<std::size_t, kContentEncodingCount> bytes_by_encoding() const {
+    std::lock_guard lock(mutex_);
+    return variant_bytes_;
+  }
 
-      // Read entire file
-      file.seekg(0, std::ios::end);
-      auto size = file.tellg();
-      file.seekg(0, std::ios::beg);
+  [[nodiscard]] std::size_t max_entry_bytes() const { return max_entry_bytes_; }
 
-      std::vector<std::uint8_t> content(size);
-      file.read(reinterpret_cast<char*>(content.data()), size);
+private:
+  struct Slot {
+    // Indexed by ContentEncoding; [identity] is always set.
+    std::array<std::shared_ptr<const CachedFile>, kContentEncodingCount> variants;
+    std::list<std::string>::iterator lru_it;
+  };
 
-      // Determine MIME type from extension
-      auto mime = mime_type_from_extension_(file_path.extension().string());
+  void load_file_(const std::filesystem::path& file_path, const std::string& cache_key);
+  void build_variants_(const std::string& key, const std::shared_ptr<const CachedFile>& identity,
+                       const std::vector<std::uint8_t>& content);
+  // Attach a variant if `identity` is still the live entry for `key`.
+  void add_variant_(const std::string& key, const std::shared_ptr<const CachedFile>& identity,
+                    std::shared_ptr<const CachedFile> variant);
+  void erase_(std::unordered_map<std::string, Slot>::iterator it);
+  void evict_lru_();
 
-      put(cache_key, std::move(content), mime);
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Slot> entries_;
+  std::list<std::string> lru_; // front = most recently used
+  std::unordered_multimap<std::string, std::string> keys_by_source_;
+  std::size_t current_size_bytes_{0};
+  std::array<std::size_t, kContentEncodingCount> variant_bytes_{};
+  std::size_t max_cache_size_bytes_;
+  std::size_t max_entry_bytes_;
+  WatchHook watch_hook_;
+  Executor executor_;
+};
 
-    } catch (const std::exception& e) {
-      std::cerr << std::format("✗ Failed to load {}: {}\n", file_path.string(), e.what());
-    }
-  }
+/**
+ * One StaticFileCache per document root (the default public root plus every
+ * virtual host root), with a single inotify instance that invalidates entries
+ * when deploys touch the files behind them. The owner polls watch_fd() and
+ * calls process_events() when it becomes readable.
+ */
+class StaticCacheRegistry {
+public:
+  StaticCacheRegistry();
+  ~StaticCacheRegistry();
 
-  void evict_lru_() {
-    // Find least recently used (lowest access_count)
-    auto lru = cache_.begin();
-    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
-      if (it->second.access_count < lru->second.access_count) {
-        lru = it;
-      }
-    }
+  StaticCacheRegistry(const StaticCacheRegistry&) = delete;
+  StaticCacheRegistry& operator=(const StaticCacheRegistry&) = delete;
 
-    if (lru != cache_.end()) {
-      current_size_bytes_ -= lru->second.content.size();
-      cache_.erase(lru);
-    }
-  }
+  // Cache for `document_root`, created on first use
+  StaticFileCache& for_root(const std::filesystem::path& document_root);
 
-  [[nodiscard]] std::string generate_etag_(const std::vector<std::uint8_t>& content) const {
-    // Simple hash-based ETag (could use MD5/SHA for production)
-    std::size_t hash = std::hash<std::string_view>{}(
-        std::string_view(reinterpret_cast<const char*>(content.data()), content.size()));
-    return std::format("\"{:016x}\"", hash);
-  }
+  // Executor handed to every cache for background compression
+  void set_executor(StaticFileCache::Executor executor);
 
-  [[nodiscard]] std::string mime_type_from_extension_(std::string_view ext) const {
-    static const std::unordered_map<std::string_view, std::string_view> mime_types = {
-        {".html", "text/html; charset=utf-8"},
-        {".htm", "text/html; charset=utf-8"},
-        {".css", "text/css; charset=utf-8"},
-        {".js", "application/javascript; charset=utf-8"},
-        {".json", "application/json; charset=utf-8"},
-        {".png", "image/png"},
-        {".jpg", "image/jpeg"},
-        {".jpeg", "image/jpeg"},
-        {".gif", "image/gif"},
-        {".svg", "image/svg+xml"},
-        {".ico", "image/x-icon"},
-        {".woff", "font/woff"},
-        {".woff2", "font/woff2"},
-        {".ttf", "font/ttf"},
-        {".txt", "text/plain; charset=utf-8"},
-        {".xml", "application/xml; charset=utf-8"},
-        {".pdf", "application/pdf"},
-    };
-
-    auto it = mime_types.find(ext);
-    return it != mime_types.end() ? std::string(it->second) : "application/octet-stream";
-  }
+  // inotify descriptor, or -1 when change notifications are unavailable
+  [[nodiscard]] int watch_fd() const { return watch_fd_; }
+  // Drain pending change notifications and invalidate affected entries
+  void process_events();
+
+private:
+  void watch_directory_(const std::filesystem::path& directory);
+  [[nodiscard]] std::vector<StaticFileCache*> caches_() const;
 
   mutable std::mutex mutex_;
-  std::unordered_map<std::string, CachedFile> cache_;
-  std::size_t current_size_bytes_{0};
-  std::size_t max_cache_size_bytes_;
+  std::map<std::string, std::unique_ptr<StaticFileCache>> caches_by_root_;
+  std::unordered_map<int, std::filesystem::path> watched_dirs_;
+  std::unordered_set<std::string> watched_paths_;
+  StaticFileCache::Executor executor_;
+  int watch_fd_{-1};
 };
 
 } // namespace neonsignal
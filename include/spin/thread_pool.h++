@@ -1,15 +1,20 @@
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <functional>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
 #include <vector>
 
 namespace neonsignal {
 
+class Gauge;
+class Histogram;
+
 class ThreadPool {
 public:
   struct ServerHostPort {
@@ -21,12 +26,21 @@ public:
   ~ThreadPool();
 
   void enqueue(std::function<void()> task);
+  // Publish queue depth and per-task queueing delay; either may be null.
+  void set_metrics(Gauge* queue_depth, Histogram* task_wait);
 
 private:
+  struct Task {
+    std::function<void()> fn;
+    std::chrono::steady_clock::time_point enqueued;
+  };
+
   void worker_();
 
   std::vector<std::thread> threads_;
-  std::queue<std::function<void()>> tasks_;
+  std::queue<Task> tasks_;
+  Gauge* queue_depth_{nullptr}; // guarded by mutex_
+  Histogram* task_wait_{nullptr};
   std::mutex mutex_;
   std::condition_variable cv_;
   bool stop_{false};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <mutex>
 #include <optional>
 #include <chrono>
 #include <string>
@@ -83,9 +84,16 @@ private:
   std::optional<WebAuthnCredential>
   find_credential(const std::vector<std::uint8_t>& credential_id) const;
 
+  // Look up and erase a pending challenge; sets error and returns false if
+  // it is unknown or expired.
+  bool consume_challenge_(const std::string& challenge, const std::string& canonical,
+                          std::string& error);
+
   std::string rp_id_;
   std::string origin_;
   Database& db_;
+  // Guards credentials_ and challenges_; shared by every reactor.
+  mutable std::mutex mutex_;
   std::vector<WebAuthnCredential> credentials_;
   std::unordered_map<std::string, Challenge> challenges_;
 };
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <openssl/ssl.h>
+
+namespace neonsignal {
+
+/**
+ * Outbound bytes for one connection as a queue of refcounted segments.
+ *
+ * A segment is an optional inline 9-byte frame header followed by a slice of
+ * a shared buffer, so staged handler output, cached static bodies and file
+ * chunks are queued without copying. flush() coalesces small segments into
+ * one SSL_write (up to kCoalesceBytes) and writes large slices directly.
+ * On a kernel TLS connection a segment's payload may instead be a range of an
+ * open file, which flush() hands to SSL_sendfile() so it never enters user
+ * space.
+ */
+class WriteQueue {
+public:
+  using Buffer = std::shared_ptr<const std::vector<std::uint8_t>>;
+  using FrameHeader = std::array<std::uint8_t, 9>;
+
+  static constexpr std::size_t kCoalesceBytes = 64 * 1024;
+
+  // Open file shared by a stream and the frames queued from it; closed when
+  // the last of them lets go.
+  struct File {
+    int fd{-1};
+
+    explicit File(int fd) : fd(fd) {}
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+    ~File();
+  };
+  using FileRef = std::shared_ptr<const File>;
+
+  enum class FlushResult { Drained, WouldBlock, Error };
+
+  // Take ownership of a byte vector (no copy)
+  void push(std::vector<std::uint8_t>&& bytes);
+  // Queue a slice of a shared buffer
+  void push(Buffer buffer, std::size_t offset, std::size_t length);
+  // Queue a frame: inline header plus a slice of a shared buffer as payload
+  void push_frame(const FrameHeader& header, Buffer buffer, std::size_t offset,
+                  std::size_t length);
+  // Queue a frame whose payload is `length` bytes of `file` at `offset`;
+  // only valid when the connection has kernel TLS send enabled.
+  void push_file_frame(const FrameHeader& header, FileRef file, std::uint64_t offset,
+                       std::size_t length);
+
+  // Write as much as the socket accepts. On Error, `ssl_error` holds the
+  // SSL_get_error() code.
+  FlushResult flush(SSL* ssl, int& ssl_error);
+
+  [[nodiscard]] std::size_t bytes() const { return bytes_; }
+  [[nodiscard]] bool empty() const { return segments_.empty(); }
+
+private:
+  struct Segment {
+    FrameHeader header{};
+    std::uint8_t header_len{0};
+    Buffer buffer;
+    std::size_t offset{0};
+    std::size_t length{0};
+    FileRef file; // payload read from here instead of `buffer`
+    std::uint64_t file_offset{0};
+
+    [[nodiscard]] std::size_t size() const { return header_len + length; }
+  };
+
+  void consume_(std::size_t n);
+
+  std::deque<Segment> segments_;
+  std::size_t front_sent_{0}; // bytes of segments_.front() already written
+  std::size_t bytes_{0};
+  std::vector<std::uint8_t> scratch_;
+};
+
+} // namespace neonsignal
@@ -354,7 +354,12 @@ int run_spin_command(int argc, char *argv[]) {
     setenv("NEONSIGNAL_THREADS", threads_value.c_str(), 1);
   }
 
-  neonsignal::install_thread_logging_prefix();
+  if (!env_set("NEONSIGNAL_REACTORS") && voltage.reactors() && *voltage.reactors() > 0) {
+    const auto reactors_value = std::to_string(*voltage.reactors());
+    setenv("NEONSIGNAL_REACTORS", reactors_value.c_str(), 1);
+  }
+
+  neonsignal::install_async_logging();
   neonsignal::Server server(config);
   server.run();
 
@@ -3,107 +3,309 @@
 
 #include <pthread.h>
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
 #include <iostream>
-#include <mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
 
 namespace neonsignal {
 
+namespace detail {
+std::atomic<int> log_level{static_cast<int>(LogLevel::info)};
+} // namespace detail
+
 namespace {
 
 constexpr std::size_t kThreadNameMax = 64;
+constexpr std::size_t kRingSlots = 4096; // power of two
+constexpr std::size_t kMaxBatchBytes = 64 * 1024;
+
+/**
+ * Bounded multi-producer ring of log lines (Vyukov's sequence-numbered
+ * slots). Producers swap their line into the slot and get the slot's old,
+ * cleared string back, so steady-state logging reuses capacity instead of
+ * allocating. Single consumer.
+ */
+class LineRing {
+public:
+  LineRing() {
+    for (std::size_t i = 0; i < kRingSlots; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  bool push(std::string& line) {
+    auto pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& slot = slots_[pos & (kRingSlots - 1)];
+      const auto seq = slot.seq.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.line.swap(line);
+          slot.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false; // full
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Append the oldest line to `out`
+  bool pop(std::string& out) {
+    auto& slot = slots_[head_ & (kRingSlots - 1)];
+    if (slot.seq.load(std::memory_order_acquire) != head_ + 1) {
+      return false;
+    }
+    out += slot.line;
+    slot.line.clear();
+    slot.seq.store(head_ + kRingSlots, std::memory_order_release);
+    ++head_;
+    return true;
+  }
+
+  [[nodiscard]] bool empty() const {
+    return slots_[head_ & (kRingSlots - 1)].seq.load(std::memory_order_acquire) != head_ + 1;
+  }
+
+private:
+  struct alignas(64) Slot {
+    std::atomic<std::size_t> seq{0};
+    std::string line;
+  };
+
+  std::array<Slot, kRingSlots> slots_;
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  alignas(64) std::size_t head_{0}; // consumer only
+};
+
+LogLevel classify(std::string_view line) {
+  if (line.starts_with("✗")) {
+    return LogLevel::error;
+  }
+  if (line.starts_with("▲")) {
+    return LogLevel::warn;
+  }
+  return LogLevel::info;
+}
 
-class ThreadPrefixBuf : public std::streambuf {
+std::string thread_prefix() {
+  char name[kThreadNameMax] = {};
+  if (pthread_getname_np(pthread_self(), name, sizeof(name)) != 0 || name[0] == '\0') {
+    std::ostringstream oss;
+    oss << std::this_thread::get_id();
+    return std::format("{}->", oss.str());
+  }
+  // If the name already contains a separator marker '>', use it as-is.
+  if (const std::string_view sv{name}; sv.find('>') != std::string_view::npos) {
+    return std::string{name};
+  }
+  return std::format("{}->", name);
+}
+
+class AsyncLogBuf : public std::streambuf {
 public:
-  explicit ThreadPrefixBuf(std::streambuf *dest) : dest_(dest) {}
+  explicit AsyncLogBuf(std::streambuf* dest)
+      : dest_(dest), drain_thread_([this] { drain_(); }) {}
+
+  ~AsyncLogBuf() override {
+    // Later writers (static destructors) go straight to stderr; everything
+    // already in the ring is still written first.
+    if (std::cerr.rdbuf() == this) {
+      std::cerr.rdbuf(dest_);
+    }
+    stop_.store(true);
+    wake_();
+    drain_thread_.join();
+  }
+
+  AsyncLogBuf(const AsyncLogBuf&) = delete;
+  AsyncLogBuf& operator=(const AsyncLogBuf&) = delete;
+
+  [[nodiscard]] std::uint64_t dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
 
 protected:
   int overflow(const int ch) override {
     if (ch == traits_type::eof()) {
       return sync() == 0 ? traits_type::not_eof(ch) : traits_type::eof();
     }
-    auto &state = line_state();
-    state.buffer_.push_back(static_cast<char>(ch));
+    auto& state = line_state();
+    state.buffer.push_back(static_cast<char>(ch));
     if (ch == '\n') {
-      flush_line(state, true);
+      submit_(state, true);
     }
     return ch;
   }
 
+  std::streamsize xsputn(const char* s, std::streamsize n) override {
+    auto& state = line_state();
+    std::string_view rest(s, static_cast<std::size_t>(n));
+    while (!rest.empty()) {
+      const auto nl = rest.find('\n');
+      if (nl == std::string_view::npos) {
+        state.buffer += rest;
+        break;
+      }
+      state.buffer += rest.substr(0, nl + 1);
+      submit_(state, true);
+      rest.remove_prefix(nl + 1);
+    }
+    return n;
+  }
+
   int sync() override {
-    auto &state = line_state();
-    if (!state.buffer_.empty()) {
-      flush_line(state, false);
-      return 0;
+    auto& state = line_state();
+    if (!state.buffer.empty()) {
+      submit_(state, false);
     }
-    return dest_->pubsync();
+    return 0;
   }
 
 private:
   struct LineState {
-    std::string buffer_;
-    bool line_open_{false};
+    std::string buffer;
+    std::string line;   // prefix + buffer, swapped into the ring
+    std::string prefix; // resolved on the thread's first line
+    bool line_open{false};
+    LogLevel level{LogLevel::info};
   };
 
-  static LineState &line_state() {
+  static LineState& line_state() {
     static thread_local LineState state;
     return state;
   }
 
-  void flush_line(LineState &state, const bool line_complete) {
-    if (state.buffer_.empty()) {
+  void submit_(LineState& state, const bool line_complete) {
+    const bool starts_line = !state.line_open;
+    if (starts_line) {
+      state.level = classify(state.buffer);
+    }
+    state.line_open = !line_complete;
+    if (!log_enabled(state.level)) {
+      state.buffer.clear();
       return;
     }
-    std::string p;
-    if (!state.line_open_) {
-      p = prefix();
+    if (state.prefix.empty()) {
+      state.prefix = thread_prefix();
+    }
+    state.line.clear();
+    if (starts_line) {
+      state.line += state.prefix;
+    }
+    state.line += state.buffer;
+    state.buffer.clear();
+    if (!ring_.push(state.line)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
     }
-    std::lock_guard<std::mutex> lock(mu_);
-    if (!p.empty()) {
-      dest_->sputn(p.data(), static_cast<std::streamsize>(p.size()));
+    // Pairs with the fence in drain_(): either the drain thread sees the new
+    // line before sleeping, or we see that it is asleep.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+      wake_();
     }
-    dest_->sputn(state.buffer_.data(), static_cast<std::streamsize>(state.buffer_.size()));
-    dest_->pubsync();
-    state.buffer_.clear();
-    state.line_open_ = !line_complete;
   }
 
-  static std::string prefix() {
-    char name[kThreadNameMax] = {};
-    if (pthread_getname_np(pthread_self(), name, sizeof(name)) != 0 || name[0] == '\0') {
-      std::ostringstream oss;
-      oss << std::this_thread::get_id();
-      return std::format("{}->", oss.str());
-    }
-    // If the name already contains a separator marker '>', use it as-is.
-    if (const std::string_view sv{name}; sv.find('>') != std::string_view::npos) {
-      return std::string{name};
+  void wake_() {
+    sleeping_.store(false);
+    sleeping_.notify_one();
+  }
+
+  void drain_() {
+    platform_utils::set_thread_name("log");
+    std::string batch;
+    std::uint64_t reported = 0;
+    for (;;) {
+      while (batch.size() < kMaxBatchBytes && ring_.pop(batch)) {
+      }
+      if (const auto lost = dropped_.load(std::memory_order_relaxed); lost != reported) {
+        batch += std::format("log->▲ log ring full, dropped {} lines\n", lost - reported);
+        reported = lost;
+      }
+      if (!batch.empty()) {
+        dest_->sputn(batch.data(), static_cast<std::streamsize>(batch.size()));
+        dest_->pubsync();
+        batch.clear();
+        continue;
+      }
+      if (stop_.load()) {
+        return;
+      }
+      sleeping_.store(true);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (ring_.empty() && !stop_.load()) {
+        sleeping_.wait(true);
+      }
+      sleeping_.store(false, std::memory_order_relaxed);
     }
-    return std::format("{}->", name);
   }
 
-  std::streambuf *dest_;
-  std::mutex mu_;
+  std::streambuf* dest_;
+  LineRing ring_;
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<bool> sleeping_{false};
+  std::atomic<bool> stop_{false};
+  std::thread drain_thread_; // last: starts draining once everything above exists
 };
 
+AsyncLogBuf* g_log_buf = nullptr;
+
+LogLevel parse_level(std::string_view value, LogLevel fallback) {
+  if (value == "debug") {
+    return LogLevel::debug;
+  }
+  if (value == "info") {
+    return LogLevel::info;
+  }
+  if (value == "warn") {
+    return LogLevel::warn;
+  }
+  if (value == "error") {
+    return LogLevel::error;
+  }
+  if (value == "off") {
+    return LogLevel::off;
+  }
+  return fallback;
+}
+
 } // namespace
 
-void install_thread_logging_prefix() {
-  static ThreadPrefixBuf buf(std::cerr.rdbuf());
+void install_async_logging() {
+  static std::streambuf* original = std::cerr.rdbuf();
+  static AsyncLogBuf buf(original);
   static bool installed = false;
   if (!installed) {
+    if (const char* env = std::getenv("NEONSIGNAL_LOG_LEVEL")) {
+      set_log_level(parse_level(env, LogLevel::info));
+    }
     std::cerr.rdbuf(&buf);
-    // Avoid per-insertion flush; ThreadPrefixBuf flushes whole lines atomically.
+    // Avoid per-insertion flush; lines are handed off whole.
     std::cerr.unsetf(std::ios_base::unitbuf);
     char name[kThreadNameMax] = {};
     if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0 && name[0] == '\0') {
       platform_utils::set_thread_name("main");
     }
+    g_log_buf = &buf;
     installed = true;
   }
 }
 
+void set_log_level(LogLevel level) {
+  detail::log_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+std::uint64_t dropped_log_lines() { return g_log_buf ? g_log_buf->dropped() : 0; }
+
 } // namespace neonsignal
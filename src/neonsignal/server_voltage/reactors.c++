@@ -0,0 +1,7 @@
+#include "neonsignal/voltage_argv.h++"
+
+namespace neonsignal {
+
+const std::optional<unsigned long long> &server_voltage::reactors() const { return reactors_; }
+
+} // namespace neonsignal
@@ -66,8 +66,8 @@ static constexpr version_t SERVER_VERSION = parse_version(NEONSIGNAL_VERSION);
 static constexpr version_t REDIRECT_VERSION = parse_version(NEONSIGNAL_REDIRECT_VERSION);
 
 // Valid flags for neonsignal
-constexpr std::array<std::string_view, 24> server_args_list{
-    {"threads", "host", "port", "webauthn-domain", "webauthn-origin", "db-path", "www-root",
+constexpr std::array<std::string_view, 25> server_args_list{
+    {"threads", "reactors", "host", "port", "webauthn-domain", "webauthn-origin", "db-path", "www-root",
      "certs-root", "working-dir",
      "mail-enabled", "mail-domains", "mail-cookie-name", "mail-cookie-ttl", "mail-url-hits",
      "mail-from", "mail-to-extra", "mail-command", "mail-allowed-ip", "mail-save-db",
@@ -172,6 +172,9 @@ server_voltage::server_voltage(int argc, char *argv[]) {
   if (args.has("threads")) {
     threads_ = args.get_option_uint("threads").threads();
   }
+  if (args.has("reactors")) {
+    reactors_ = args.get_option_uint("reactors").reactors();
+  }
   if (args.has("host")) {
     host_ = args.get_option_string("host").host();
   }
@@ -0,0 +1,40 @@
+#include "neonsignal/voltage_argv/check.h++"
+
+#include <cstdlib>
+#include <format>
+#include <stdexcept>
+#include <variant>
+
+namespace neonsignal::voltage_argv {
+
+unsigned long long check::reactors() const {
+  unsigned long long reactor_count;
+
+  if (std::holds_alternative<unsigned long long>(this->value_)) {
+    reactor_count = std::get<unsigned long long>(this->value_);
+  } else if (std::holds_alternative<std::nullptr_t>(this->value_)) {
+    // Check environment variable
+    const char *env_reactors = std::getenv("NEONSIGNAL_REACTORS");
+    if (env_reactors != nullptr) {
+      reactor_count = std::stoull(env_reactors);
+    } else {
+      reactor_count = 1; // Default
+    }
+  } else {
+    throw std::invalid_argument(
+        std::format("invalid argument type for --reactors, expected number"));
+  }
+
+  if (reactor_count == 0) {
+    throw std::invalid_argument("--reactors must be greater than 0");
+  }
+
+  if (reactor_count > 256) {
+    throw std::out_of_range(
+        std::format("--reactors {} exceeds maximum allowed value of 256", reactor_count));
+  }
+
+  return reactor_count;
+}
+
+} // namespace neonsignal::voltage_argv
@@ -10,6 +10,8 @@ std::string help::get_help_topic_(Topic_ topic) const {
     return version_();
   case Topic_::threads:
     return threads_();
+  case Topic_::reactors:
+    return reactors_();
   case Topic_::host:
     return host_();
   case Topic_::port:
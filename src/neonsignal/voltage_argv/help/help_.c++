@@ -57,6 +57,7 @@ std::string help::help_() const {
       "  {}       Install a repository into www-root\n\n"
       "{}\n"
       "  {}           Number of worker threads (default: 3)\n"
+      "  {}          Number of event-loop reactors (default: 1)\n"
       "  {}           Bind address (default: 0.0.0.0)\n"
       "  {}              HTTPS listen port (default: 9443)\n"
       "  {} WebAuthn Relying Party ID\n"
@@ -99,7 +100,7 @@ std::string help::help_() const {
       "  {}           Show version information\n\n"
       "{}\n"
       "  CLI flags are overridden by environment variables when set:\n"
-      "    NEONSIGNAL_THREADS, NEONSIGNAL_HOST, NEONSIGNAL_PORT\n"
+      "    NEONSIGNAL_THREADS, NEONSIGNAL_REACTORS, NEONSIGNAL_HOST, NEONSIGNAL_PORT\n"
       "    NEONSIGNAL_WEBAUTHN_DOMAIN, NEONSIGNAL_WEBAUTHN_ORIGIN\n"
       "    NEONSIGNAL_DB_PATH, NEONSIGNAL_WWW_ROOT, NEONSIGNAL_CERTS_ROOT\n"
       "    NEONSIGNAL_WORKING_DIR\n"
@@ -116,7 +117,8 @@ std::string help::help_() const {
       ansi("Description:").stylish().bold().str(), ansi("Commands:").stylish().bold().str(),
       ansi("spin").bright_cyan().str(), ansi("install").bright_cyan().str(),
       ansi("→ Spin Options:").stylish().bold().str(),
-      ansi("--threads=<n>").bright_green().str(), ansi("--host=<addr>").bright_green().str(),
+      ansi("--threads=<n>").bright_green().str(), ansi("--reactors=<n>").bright_green().str(),
+      ansi("--host=<addr>").bright_green().str(),
       ansi("--port=<n>").bright_green().str(), ansi("--webauthn-domain=<id>").bright_green().str(),
       ansi("--webauthn-origin=<url>").bright_green().str(),
       ansi("--db-path=<path>").bright_green().str(), ansi("--www-root=<path>").bright_green().str(),
@@ -0,0 +1,34 @@
+#include "neonsignal/voltage_argv/help.h++"
+
+#include <ansi.h++>
+
+#include <format>
+
+namespace neonsignal::voltage_argv {
+
+std::string help::reactors_() const {
+  using nutsloop::ansi;
+
+  return std::format(
+      "{}\n"
+      "  {}\n\n"
+      "{}\n"
+      "  Number of event-loop reactors. Each reactor runs its own event loop on a\n"
+      "  dedicated thread with its own SO_REUSEPORT listener, so the kernel spreads\n"
+      "  incoming connections across them. The worker thread pool, caches, database\n"
+      "  and WebAuthn state are shared by all reactors.\n\n"
+      "{}\n"
+      "  {}\n\n"
+      "{}\n"
+      "  1 (single event loop)\n\n"
+      "{}\n"
+      "  {} spin --reactors=2\n"
+      "  {} spin --reactors=4 --threads=8\n",
+      ansi("NAME").stylish().bold().str(), ansi("--reactors=<n>").bright_green().str(),
+      ansi("DESCRIPTION").stylish().bold().str(), ansi("ENVIRONMENT").stylish().bold().str(),
+      ansi("NEONSIGNAL_REACTORS").bright_cyan().str(), ansi("DEFAULT").stylish().bold().str(),
+      ansi("EXAMPLES").stylish().bold().str(), ansi("  <binary>").bright_yellow().str(),
+      ansi("  <binary>").bright_yellow().str());
+}
+
+} // namespace neonsignal::voltage_argv
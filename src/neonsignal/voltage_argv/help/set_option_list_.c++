@@ -11,6 +11,7 @@ void help::set_option_list_() {
 
   if (mode() == Mode::server) {
     option_list_.insert({{"threads", Topic_::threads},
+                         {"reactors", Topic_::reactors},
                          {"host", Topic_::host},
                          {"port", Topic_::port},
                          {"webauthn-domain", Topic_::webauthn_domain},
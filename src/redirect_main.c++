@@ -53,7 +53,7 @@ int main(int argc, char *argv[]) {
       return 0;
     }
 
-    neonsignal::install_thread_logging_prefix();
+    neonsignal::install_async_logging();
 
     int instances = read_int_env("REDIRECT_INSTANCES", 1);
     int listen_port = read_int_env("REDIRECT_PORT", 9090);
@@ -8,27 +8,36 @@ namespace neonsignal {
 
 bool ApiHandler::auth_user_check(
     const std::shared_ptr<Http2Connection>& conn, std::uint32_t stream_id,
-    const std::unordered_map<std::string, std::string>& headers) {
-  auto user_hdr = headers.find("x-user");
-  std::string user = user_hdr == headers.end() ? "" : user_hdr->second;
+    const HeaderView& headers) {
+  std::string user{headers.get("x-user").value_or(std::string_view{})};
   if (user.empty()) {
     std::string body = "{\"error\":\"missing user\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 400, "application/json",
+    build_response_frames(*conn, stream_id, 400, "application/json",
                           body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
   }
 
-  bool exists = auth_.user_exists(user);
-  std::string body = std::string("{\"user\":\"") + user +
-                     "\",\"exists\":" + (exists ? "true" : "false") + "}";
-  std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-  build_response_frames(conn->write_buf, stream_id, 200, "application/json",
-                        body_bytes);
-  conn->events |= EventMask::Write;
-  loop_.update_fd(conn->fd, conn->events);
+  // Email index lookup off the loop thread
+  db_.async(
+      pool_, loop_,
+      [user](Database& db) { return db.find_user_by_email(user).has_value(); },
+      [this, conn, stream_id, user](std::optional<bool> exists) {
+        if (conn->closed) {
+          return;
+        }
+        int status = exists ? 200 : 500;
+        std::string body = exists ? std::string("{\"user\":\"") + user + "\",\"exists\":" +
+                                        (*exists ? "true" : "false") + "}"
+                                  : std::string("{\"error\":\"database unavailable\"}");
+        std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
+        build_response_frames(*conn, stream_id, status, "application/json",
+                              body_bytes);
+        conn->events |= EventMask::Write;
+        loop_.update_fd(conn->fd, conn->events);
+      });
   return true;
 }
 
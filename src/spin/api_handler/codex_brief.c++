@@ -174,12 +174,12 @@ std::string extract_boundary(std::string_view content_type) {
 
 bool ApiHandler::codex_brief_headers(
     const std::shared_ptr<Http2Connection>& conn, std::uint32_t stream_id,
-    const std::unordered_map<std::string, std::string>& headers,
+    const HeaderView& headers,
     const std::string& path, const std::string& method) {
   if (method != "POST") {
     std::string body = "{\"error\":\"method not allowed\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 405, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 405, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -190,9 +190,8 @@ bool ApiHandler::codex_brief_headers(
   st.method = method;
   st.expect_body = true;
   st.is_codex = true;
-  auto ct = headers.find("content-type");
-  if (ct != headers.end()) {
-    st.content_type = ct->second;
+  if (auto ct = headers.get("content-type")) {
+    st.content_type = *ct;
   }
   conn->streams[stream_id] = std::move(st);
   return true;
@@ -43,7 +43,7 @@ bool ApiHandler::codex_image(const std::shared_ptr<Http2Connection>& conn,
   if (id.empty()) {
     std::string body = "missing id";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 400, "text/plain; charset=utf-8",
+    build_response_frames(*conn, stream_id, 400, "text/plain; charset=utf-8",
                           body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
@@ -53,7 +53,7 @@ bool ApiHandler::codex_image(const std::shared_ptr<Http2Connection>& conn,
   if (!record || record->image_size == 0) {
     std::string body = "not found";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 404, "text/plain; charset=utf-8",
+    build_response_frames(*conn, stream_id, 404, "text/plain; charset=utf-8",
                           body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
@@ -63,7 +63,7 @@ bool ApiHandler::codex_image(const std::shared_ptr<Http2Connection>& conn,
   if (!bytes) {
     std::string body = "not found";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 404, "text/plain; charset=utf-8",
+    build_response_frames(*conn, stream_id, 404, "text/plain; charset=utf-8",
                           body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
@@ -72,7 +72,7 @@ bool ApiHandler::codex_image(const std::shared_ptr<Http2Connection>& conn,
   std::string content_type = record->image_type.empty()
                                  ? "application/octet-stream"
                                  : record->image_type;
-  build_response_frames(conn->write_buf, stream_id, 200, content_type, *bytes);
+  build_response_frames(*conn, stream_id, 200, content_type, *bytes);
   conn->events |= EventMask::Write;
   loop_.update_fd(conn->fd, conn->events);
   return true;
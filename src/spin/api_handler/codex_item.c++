@@ -43,7 +43,7 @@ bool ApiHandler::codex_item(const std::shared_ptr<Http2Connection>& conn,
   if (id.empty()) {
     std::string body = "{\"error\":\"missing id\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 400, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 400, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -52,7 +52,7 @@ bool ApiHandler::codex_item(const std::shared_ptr<Http2Connection>& conn,
   if (!record) {
     std::string body = "{\"error\":\"not found\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 404, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 404, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -74,7 +74,7 @@ bool ApiHandler::codex_item(const std::shared_ptr<Http2Connection>& conn,
   body += "\"image_size\":" + std::to_string(record->image_size);
   body += "}";
   std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-  build_response_frames(conn->write_buf, stream_id, 200, "application/json", body_bytes);
+  build_response_frames(*conn, stream_id, 200, "application/json", body_bytes);
   conn->events |= EventMask::Write;
   loop_.update_fd(conn->fd, conn->events);
   return true;
@@ -4,30 +4,92 @@
 #include "spin/event_mask.h++"
 #include "spin/http2_listener_helpers.h++"
 
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+
 namespace neonsignal {
 
-bool ApiHandler::codex_list(const std::shared_ptr<Http2Connection>& conn,
-                            std::uint32_t stream_id) {
-  auto items = db_.list_codex(25);
-  std::string body = "{\"items\":[";
-  for (std::size_t i = 0; i < items.size(); ++i) {
-    const auto& item = items[i];
-    body += "{";
-    body += "\"id\":\"" + item.id + "\",";
-    body += "\"title\":\"" + item.title + "\",";
-    body += "\"created_at\":" + std::to_string(item.created_at) + ",";
-    body += "\"bytes\":" + std::to_string(item.size) + ",";
-    body += "\"has_image\":" + std::string(item.image_size ? "true" : "false");
-    body += "}";
-    if (i + 1 < items.size()) {
-      body += ",";
+namespace {
+
+constexpr std::size_t kDefaultPageSize = 25;
+constexpr std::size_t kMaxPageSize = 100;
+
+std::string query_param(std::string_view path, std::string_view key) {
+  auto qpos = path.find('?');
+  if (qpos == std::string_view::npos) {
+    return {};
+  }
+  std::string_view query = path.substr(qpos + 1);
+  while (!query.empty()) {
+    auto amp = query.find('&');
+    std::string_view chunk = query.substr(0, amp);
+    auto eq = chunk.find('=');
+    if (eq != std::string_view::npos) {
+      auto k = chunk.substr(0, eq);
+      auto v = chunk.substr(eq + 1);
+      if (k == key) {
+        return std::string(v);
+      }
+    }
+    if (amp == std::string_view::npos) {
+      break;
     }
+    query.remove_prefix(amp + 1);
   }
-  body += "]}";
-  std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-  build_response_frames(conn->write_buf, stream_id, 200, "application/json", body_bytes);
-  conn->events |= EventMask::Write;
-  loop_.update_fd(conn->fd, conn->events);
+  return {};
+}
+
+} // namespace
+
+bool ApiHandler::codex_list(const std::shared_ptr<Http2Connection>& conn,
+                            std::uint32_t stream_id, const std::string& path) {
+  auto cursor = query_param(path, "cursor");
+  std::size_t limit = kDefaultPageSize;
+  if (auto text = query_param(path, "limit"); !text.empty()) {
+    std::from_chars(text.data(), text.data() + text.size(), limit);
+    limit = std::clamp<std::size_t>(limit, 1, kMaxPageSize);
+  }
+
+  // The index walk runs on the pool; the response is built back on the loop.
+  db_.async(
+      pool_, loop_,
+      [limit, cursor](Database& db) { return db.list_codex_page(limit, cursor); },
+      [this, conn, stream_id](std::optional<CodexPage> page) {
+        if (conn->closed) {
+          return;
+        }
+        if (!page) {
+          std::string body = "{\"error\":\"database unavailable\"}";
+          std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
+          build_response_frames(*conn, stream_id, 500, "application/json", body_bytes);
+        } else {
+          const auto& items = page->items;
+          std::string body = "{\"items\":[";
+          for (std::size_t i = 0; i < items.size(); ++i) {
+            const auto& item = items[i];
+            body += "{";
+            body += "\"id\":\"" + item.id + "\",";
+            body += "\"title\":\"" + item.title + "\",";
+            body += "\"created_at\":" + std::to_string(item.created_at) + ",";
+            body += "\"bytes\":" + std::to_string(item.size) + ",";
+            body += "\"has_image\":" + std::string(item.image_size ? "true" : "false");
+            body += "}";
+            if (i + 1 < items.size()) {
+              body += ",";
+            }
+          }
+          body += "]";
+          if (!page->next_cursor.empty()) {
+            body += ",\"next_cursor\":\"" + page->next_cursor + "\"";
+          }
+          body += "}";
+          std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
+          build_response_frames(*conn, stream_id, 200, "application/json", body_bytes);
+        }
+        conn->events |= EventMask::Write;
+        loop_.update_fd(conn->fd, conn->events);
+      });
   return true;
 }
 
@@ -41,7 +41,7 @@ bool ApiHandler::codex_run_start(const std::shared_ptr<Http2Connection>& conn,
   if (method != "POST") {
     std::string body = "{\"error\":\"method-not-allowed\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 405, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 405, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -51,7 +51,7 @@ bool ApiHandler::codex_run_start(const std::shared_ptr<Http2Connection>& conn,
   if (id.empty()) {
     std::string body = "{\"error\":\"missing-id\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 400, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 400, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -61,7 +61,7 @@ bool ApiHandler::codex_run_start(const std::shared_ptr<Http2Connection>& conn,
   if (!run) {
     std::string body = "{\"error\":\"run-start-failed\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 500, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 500, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -70,7 +70,7 @@ bool ApiHandler::codex_run_start(const std::shared_ptr<Http2Connection>& conn,
   std::string body = "{\"run_id\":\"" + run->id + "\",\"status\":\"" + run->status +
                      "\",\"brief_id\":\"" + run->brief_id + "\"}";
   std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-  build_response_frames(conn->write_buf, stream_id, 200, "application/json", body_bytes);
+  build_response_frames(*conn, stream_id, 200, "application/json", body_bytes);
   conn->events |= EventMask::Write;
   loop_.update_fd(conn->fd, conn->events);
   return true;
@@ -41,7 +41,7 @@ bool ApiHandler::codex_run_stdout(const std::shared_ptr<Http2Connection>& conn,
   if (id.empty()) {
     std::string body = "{\"error\":\"missing-id\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 400, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 400, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -50,12 +50,12 @@ bool ApiHandler::codex_run_stdout(const std::shared_ptr<Http2Connection>& conn,
   if (!bytes) {
     std::string body = "{\"error\":\"not-found\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 404, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 404, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
   }
-  build_response_frames(conn->write_buf, stream_id, 200, "text/plain", *bytes);
+  build_response_frames(*conn, stream_id, 200, "text/plain", *bytes);
   conn->events |= EventMask::Write;
   loop_.update_fd(conn->fd, conn->events);
   return true;
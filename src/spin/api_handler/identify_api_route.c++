@@ -74,6 +74,12 @@ ApiRoute identify_api_route(std::string_view path) {
   if (clean == routes::api::kRedirectService) {
     return ApiRoute::RedirectService;
   }
+  if (clean == routes::api::kMetrics) {
+    return ApiRoute::Metrics;
+  }
+  if (clean == routes::api::kMetricsStream) {
+    return ApiRoute::MetricsStream;
+  }
   return ApiRoute::None;
 }
 
@@ -59,7 +59,7 @@ bool ApiHandler::incoming_data(const std::shared_ptr<Http2Connection> &conn,
   if (method != "POST") {
     std::string body = "Method Not Allowed";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 405, "text/plain; charset=utf-8", body_bytes);
+    build_response_frames(*conn, stream_id, 405, "text/plain; charset=utf-8", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true; // handled (405)
@@ -83,7 +83,7 @@ bool ApiHandler::incoming_data(const std::shared_ptr<Http2Connection> &conn,
   if (!st.file.is_open()) {
     std::string body = "{\"error\":\"cannot open upload path\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 500, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 500, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     std::cerr << "✗ UPLOAD init failed (open) fd=" << conn->fd << " stream=" << stream_id
@@ -76,27 +76,6 @@ std::string extract_json_string(std::string_view json, std::string_view key) {
   return {};
 }
 
-std::optional<std::string> extract_cookie(
-    const std::unordered_map<std::string, std::string>& headers,
-    std::string_view name) {
-  auto it = headers.find("cookie");
-  if (it == headers.end()) {
-    return std::nullopt;
-  }
-  std::string_view cookie = it->second;
-  std::string needle = std::string(name) + "=";
-  std::size_t pos = cookie.find(needle);
-  if (pos == std::string_view::npos) {
-    return std::nullopt;
-  }
-  pos += needle.size();
-  std::size_t end = cookie.find(';', pos);
-  if (end == std::string_view::npos) {
-    end = cookie.size();
-  }
-  return std::string(cookie.substr(pos, end - pos));
-}
-
 std::string normalize_authority(std::string_view authority) {
   if (auto pos = authority.find(':'); pos != std::string_view::npos) {
     authority = authority.substr(0, pos);
@@ -229,14 +208,14 @@ std::string normalize_message(std::string message) {
 
 bool ApiHandler::mail_send_headers(const std::shared_ptr<Http2Connection>& conn,
                                    std::uint32_t stream_id,
-                                   const std::unordered_map<std::string, std::string>& headers,
+                                   const HeaderView& headers,
                                    const std::string& path,
                                    const std::string& method,
                                    const std::string& authority) {
   if (!mail_config_.enabled) {
     std::string body = "{\"error\":\"mail disabled\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 404, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 404, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -245,7 +224,7 @@ bool ApiHandler::mail_send_headers(const std::shared_ptr<Http2Connection>& conn,
   if (method != "POST") {
     std::string body = "{\"error\":\"method not allowed\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 405, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 405, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -254,7 +233,7 @@ bool ApiHandler::mail_send_headers(const std::shared_ptr<Http2Connection>& conn,
   if (!is_allowed_domain(authority, mail_config_)) {
     std::string body = "{\"error\":\"requests from this domain are not allowed\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 403, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 403, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -264,7 +243,7 @@ bool ApiHandler::mail_send_headers(const std::shared_ptr<Http2Connection>& conn,
   if (client_ip.empty()) {
     std::string body = "{\"error\":\"missing or invalid anti-spam cookie\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 403, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 403, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -274,18 +253,17 @@ bool ApiHandler::mail_send_headers(const std::shared_ptr<Http2Connection>& conn,
       client_ip != mail_config_.allowed_ip_address) {
     std::string body = "{\"error\":\"requests from this ip are not allowed\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 403, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 403, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
   }
 
-  auto cookie_code = extract_cookie(headers, mail_config_.cookie_name);
-  if (!cookie_code || cookie_code->empty() ||
-      !mail_cookie_store_.validate(client_ip, *cookie_code)) {
+  std::string cookie_code{headers.cookie(mail_config_.cookie_name).value_or(std::string_view{})};
+  if (cookie_code.empty() || !mail_cookie_store_.validate(client_ip, cookie_code)) {
     std::string body = "{\"error\":\"missing or invalid anti-spam cookie\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 403, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 403, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -296,7 +274,7 @@ bool ApiHandler::mail_send_headers(const std::shared_ptr<Http2Connection>& conn,
   st.method = method;
   st.expect_body = true;
   st.is_mail_send = true;
-  st.mail_cookie_code = *cookie_code;
+  st.mail_cookie_code = std::move(cookie_code);
   st.client_ip = std::move(client_ip);
   conn->streams[stream_id] = std::move(st);
   return true;
@@ -0,0 +1,40 @@
+#include "spin/api_handler.h++"
+
+#include "neonsignal/logging.h++"
+#include "spin/event_loop.h++"
+#include "spin/event_mask.h++"
+#include "spin/http2_listener_helpers.h++"
+
+#include <iostream>
+
+namespace neonsignal {
+
+bool ApiHandler::metrics(const std::shared_ptr<Http2Connection>& conn,
+                         std::uint32_t stream_id,
+                         const std::string& path,
+                         const std::string& method,
+                         const std::string& authority) {
+  if (method != "GET") {
+    std::string body = "Method Not Allowed";
+    std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
+    build_response_frames(*conn, stream_id, 405,
+                          "text/plain; charset=utf-8", body_bytes);
+    conn->events |= EventMask::Write;
+    loop_.update_fd(conn->fd, conn->events);
+    return true;
+  }
+  auto body = metrics_.prometheus_text();
+  std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
+  build_response_frames(*conn, stream_id, 200, "text/plain; version=0.0.4; charset=utf-8",
+                        body_bytes);
+  conn->events |= EventMask::Write;
+  loop_.update_fd(conn->fd, conn->events);
+  if (log_enabled(LogLevel::debug)) {
+    std::cerr << "• HEADERS on fd=" << conn->fd << " stream=" << stream_id
+              << " path=" << path << " method=" << method
+              << " authority=" << authority << " (metrics)\n";
+  }
+  return true;
+}
+
+} // namespace neonsignal
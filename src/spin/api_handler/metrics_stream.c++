@@ -0,0 +1,29 @@
+#include "spin/api_handler.h++"
+
+#include "neonsignal/logging.h++"
+#include "spin/event_loop.h++"
+#include "spin/event_mask.h++"
+#include "spin/http2_listener_helpers.h++"
+
+#include <iostream>
+
+namespace neonsignal {
+
+bool ApiHandler::metrics_stream(
+    const std::shared_ptr<Http2Connection>& conn, std::uint32_t stream_id,
+    const std::string& path, const std::string& method,
+    const std::string& authority) {
+  append_headers_frame(*conn, stream_id, 200, "text/event-stream", {});
+  // Sends the channel's latest snapshot, then one per tick when it changed.
+  sse_.subscribe(SSEBroadcaster::Channel::Metrics, conn, stream_id);
+  conn->events |= EventMask::Write;
+  loop_.update_fd(conn->fd, conn->events);
+  if (log_enabled(LogLevel::debug)) {
+    std::cerr << "• HEADERS on fd=" << conn->fd << " stream=" << stream_id
+              << " path=" << path << " method=" << method
+              << " authority=" << authority << " (metrics sse)\n";
+  }
+  return true;
+}
+
+} // namespace neonsignal
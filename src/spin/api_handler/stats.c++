@@ -1,5 +1,6 @@
 #include "spin/api_handler.h++"
 
+#include "neonsignal/logging.h++"
 #include "spin/event_loop.h++"
 #include "spin/event_mask.h++"
 #include "spin/http2_listener_helpers.h++"
@@ -18,13 +19,15 @@ bool ApiHandler::stats(const std::shared_ptr<Http2Connection>& conn,
                      ",\"page_views\":" +
                      std::to_string(page_views_.load()) + "}";
   std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-  build_response_frames(conn->write_buf, stream_id, 200, "application/json",
+  build_response_frames(*conn, stream_id, 200, "application/json",
                         body_bytes);
   conn->events |= EventMask::Write;
   loop_.update_fd(conn->fd, conn->events);
-  std::cerr << "• HEADERS on fd=" << conn->fd << " stream=" << stream_id
-            << " path=" << path << " method=" << method
-            << " authority=" << authority << " (api)\n";
+  if (log_enabled(LogLevel::debug)) {
+    std::cerr << "• HEADERS on fd=" << conn->fd << " stream=" << stream_id
+              << " path=" << path << " method=" << method
+              << " authority=" << authority << " (api)\n";
+  }
   return true;
 }
 
@@ -12,38 +12,16 @@ namespace neonsignal {
 
 using namespace std::string_view_literals;
 
-namespace {
-
-std::string extract_cookie(const std::string& cookie_header, std::string_view name) {
-  std::string target = std::string(name) + "=";
-  auto pos = cookie_header.find(target);
-  if (pos == std::string::npos) {
-    return {};
-  }
-  pos += target.size();
-  auto end = cookie_header.find(';', pos);
-  if (end == std::string::npos) {
-    return cookie_header.substr(pos);
-  }
-  return cookie_header.substr(pos, end - pos);
-}
-
-} // namespace
-
 bool ApiHandler::user_enroll(const std::shared_ptr<Http2Connection>& conn,
                              std::uint32_t stream_id,
-                             const std::unordered_map<std::string, std::string>& headers) {
+                             const HeaderView& headers) {
   // GET request - return WebAuthn options for enrollment
-  auto cookie_it = headers.find("cookie");
-  std::string session_id;
-  if (cookie_it != headers.end()) {
-    session_id = extract_cookie(cookie_it->second, "ns_session");
-  }
+  std::string session_id{headers.cookie("ns_session").value_or(std::string_view{})};
 
   if (session_id.empty()) {
     std::string body = "{\"error\":\"session required\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 401, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 401, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -54,7 +32,7 @@ bool ApiHandler::user_enroll(const std::shared_ptr<Http2Connection>& conn,
   if (!session) {
     std::string body = "{\"error\":\"invalid session\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 401, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 401, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -63,7 +41,7 @@ bool ApiHandler::user_enroll(const std::shared_ptr<Http2Connection>& conn,
   if (session->state != "pre_webauthn") {
     std::string body = "{\"error\":\"invalid session state\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 403, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 403, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -74,7 +52,7 @@ bool ApiHandler::user_enroll(const std::shared_ptr<Http2Connection>& conn,
   if (!user) {
     std::string body = "{\"error\":\"user not found\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 404, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 404, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -85,14 +63,14 @@ bool ApiHandler::user_enroll(const std::shared_ptr<Http2Connection>& conn,
   if (opts.json.empty()) {
     std::string body = "{\"error\":\"failed to generate options\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 500, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 500, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
   }
 
   std::vector<std::uint8_t> body_bytes(opts.json.begin(), opts.json.end());
-  build_response_frames(conn->write_buf, stream_id, 200, "application/json", body_bytes);
+  build_response_frames(*conn, stream_id, 200, "application/json", body_bytes);
   conn->events |= EventMask::Write;
   loop_.update_fd(conn->fd, conn->events);
   return true;
@@ -100,20 +78,16 @@ bool ApiHandler::user_enroll(const std::shared_ptr<Http2Connection>& conn,
 
 bool ApiHandler::user_enroll_headers(const std::shared_ptr<Http2Connection>& conn,
                                      std::uint32_t stream_id,
-                                     const std::unordered_map<std::string, std::string>& headers,
+                                     const HeaderView& headers,
                                      const std::string& path,
                                      const std::string& method) {
   // POST request - finish enrollment with WebAuthn attestation
-  auto cookie_it = headers.find("cookie");
-  std::string session_id;
-  if (cookie_it != headers.end()) {
-    session_id = extract_cookie(cookie_it->second, "ns_session");
-  }
+  std::string session_id{headers.cookie("ns_session").value_or(std::string_view{})};
 
   if (session_id.empty()) {
     std::string body = "{\"error\":\"session required\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 401, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 401, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -124,7 +98,7 @@ bool ApiHandler::user_enroll_headers(const std::shared_ptr<Http2Connection>& con
   if (!session) {
     std::string body = "{\"error\":\"invalid session\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 401, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 401, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -133,7 +107,7 @@ bool ApiHandler::user_enroll_headers(const std::shared_ptr<Http2Connection>& con
   if (session->state != "pre_webauthn") {
     std::string body = "{\"error\":\"invalid session state\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 403, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 403, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
@@ -69,7 +69,7 @@ bool ApiHandler::user_verify_headers(const std::shared_ptr<Http2Connection>& con
   if (method != "POST") {
     std::string body = "{\"error\":\"method not allowed\"}";
     std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-    build_response_frames(conn->write_buf, stream_id, 405, "application/json", body_bytes);
+    build_response_frames(*conn, stream_id, 405, "application/json", body_bytes);
     conn->events |= EventMask::Write;
     loop_.update_fd(conn->fd, conn->events);
     return true;
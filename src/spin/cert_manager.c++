@@ -2,7 +2,7 @@
 
 namespace neonsignal {
 
-CertManager::CertManager(std::filesystem::path certs_root)
-    : certs_root_(std::move(certs_root)) {}
+CertManager::CertManager(std::filesystem::path certs_root, bool enable_ktls)
+    : certs_root_(std::move(certs_root)), ktls_(enable_ktls) {}
 
 } // namespace neonsignal
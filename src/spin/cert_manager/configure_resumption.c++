@@ -0,0 +1,28 @@
+#include "spin/cert_manager.h++"
+
+namespace neonsignal {
+
+namespace {
+
+constexpr unsigned char kSessionIdContext[] = "neonsignal";
+
+} // namespace
+
+void CertManager::configure_resumption(SSL_CTX *ctx) {
+  // OpenSSL looks sessions and tickets up on the context a connection was
+  // created on, but checks them against the id context of the one SNI
+  // switched to, so every context must agree on it.
+  SSL_CTX_set_session_id_context(ctx, kSessionIdContext, sizeof(kSessionIdContext) - 1);
+  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+  SSL_CTX_sess_set_cache_size(ctx, kSessionCacheSize);
+  SSL_CTX_set_timeout(ctx, static_cast<long>(SessionTicketKeys::kTicketLifetime.count()));
+  // One ticket per full handshake; resumed handshakes get a fresh one.
+  SSL_CTX_set_num_tickets(ctx, 1);
+  ticket_keys_.install(ctx);
+
+  // 0-RTT data can be replayed by anyone who captured it; refuse it.
+  SSL_CTX_set_max_early_data(ctx, 0);
+  SSL_CTX_set_recv_max_early_data(ctx, 0);
+}
+
+} // namespace neonsignal
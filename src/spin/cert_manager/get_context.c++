@@ -1,6 +1,7 @@
 #include "spin/cert_manager.h++"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <shared_mutex>
 
@@ -21,47 +22,36 @@ std::string CertManager::normalize_hostname(std::string_view hostname) {
 }
 
 SSL_CTX *CertManager::get_context(std::string_view hostname) const {
-  std::shared_lock lock(mutex_);
-
-  std::string normalized = normalize_hostname(hostname);
+  // DNS names are at most 253 octets; anything longer cannot be indexed.
+  constexpr std::size_t kMaxHostname = 256;
 
-  // 1. Exact match
-  if (auto it = exact_certs_.find(normalized); it != exact_certs_.end()) {
-    return it->second->ssl_ctx.get();
+  if (auto pos = hostname.find(':'); pos != std::string_view::npos) {
+    hostname = hostname.substr(0, pos);
   }
-
-  // 2. Wildcard match (*.example.com matches sub.example.com)
-  for (const auto &wc : wildcard_certs_) {
-    if (normalized.size() > wc->domain.size() + 1) {
-      auto suffix_start = normalized.size() - wc->domain.size();
-      if (normalized[suffix_start - 1] == '.' &&
-          normalized.substr(suffix_start) == wc->domain) {
-        return wc->ssl_ctx.get();
-      }
-    }
+  std::array<char, kMaxHostname> buffer;
+  std::string_view host;
+  if (hostname.size() <= buffer.size()) {
+    std::transform(hostname.begin(), hostname.end(), buffer.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    host = std::string_view(buffer.data(), hostname.size());
   }
 
-  // 3. Check if hostname is covered by any cert's SAN
-  for (const auto &[name, bundle] : exact_certs_) {
-    for (const auto &san : bundle->san_names) {
-      if (san == normalized) {
-        return bundle->ssl_ctx.get();
-      }
-      // Wildcard SAN match
-      if (san.starts_with("*.")) {
-        std::string_view san_domain = std::string_view(san).substr(2);
-        if (normalized.size() > san_domain.size() + 1) {
-          auto suffix_start = normalized.size() - san_domain.size();
-          if (normalized[suffix_start - 1] == '.' &&
-              normalized.substr(suffix_start) == san_domain) {
-            return bundle->ssl_ctx.get();
-          }
-        }
+  std::shared_lock lock(mutex_);
+
+  if (!host.empty()) {
+    // 1. Exact name (certificate directory or subjectAltName)
+    if (auto it = hosts_.find(host); it != hosts_.end()) {
+      return it->second;
+    }
+    // 2. Wildcard covering the first label: sub.example.com -> .example.com
+    if (auto dot = host.find('.'); dot != std::string_view::npos) {
+      if (auto it = hosts_.find(host.substr(dot)); it != hosts_.end()) {
+        return it->second;
       }
     }
   }
 
-  // 4. Return default
+  // 3. Return default
   return default_cert_ ? default_cert_->ssl_ctx.get() : nullptr;
 }
 
@@ -0,0 +1,39 @@
+#include "spin/cert_manager.h++"
+
+#include <iostream>
+
+namespace neonsignal {
+
+void CertManager::index_hostnames() {
+  // Inserted from most to least specific; the first owner of a name wins.
+  // A wildcard covers exactly one label (RFC 6125 §6.4.3), so "*.example.com"
+  // is stored as ".example.com" and probed with the name minus its first label.
+  for (const auto &[name, bundle] : exact_certs_) {
+    if (name != "_default") {
+      hosts_.try_emplace(name, bundle->ssl_ctx.get());
+    }
+  }
+  for (const auto &bundle : wildcard_certs_) {
+    hosts_.try_emplace("." + normalize_hostname(bundle->domain), bundle->ssl_ctx.get());
+  }
+
+  auto add_sans = [this](const CertificateBundle &bundle) {
+    for (const auto &san : bundle.san_names) {
+      std::string host = normalize_hostname(san);
+      if (host.starts_with("*.")) {
+        host.erase(0, 1);
+      }
+      hosts_.try_emplace(std::move(host), bundle.ssl_ctx.get());
+    }
+  };
+  for (const auto &[name, bundle] : exact_certs_) {
+    add_sans(*bundle);
+  }
+  for (const auto &bundle : wildcard_certs_) {
+    add_sans(*bundle);
+  }
+
+  std::cerr << "• neonsignal->CertManager: " << hosts_.size() << " hostnames indexed\n";
+}
+
+} // namespace neonsignal
@@ -35,6 +35,7 @@ bool CertManager::initialize() {
   exact_certs_.clear();
   wildcard_certs_.clear();
   default_cert_ = nullptr;
+  hosts_.clear();
 
   if (!std::filesystem::is_directory(certs_root_)) {
     std::cerr << "✗ neonsignal->CertManager: certs directory not found: " << certs_root_ << '\n';
@@ -86,6 +87,7 @@ bool CertManager::initialize() {
     }
   }
 
+  index_hostnames();
   return default_cert_ != nullptr;
 }
 
@@ -157,6 +159,15 @@ bool CertManager::configure_ssl_ctx(CertificateBundle &bundle) {
   // Configure ALPN for HTTP/2
   SSL_CTX_set_alpn_select_cb(ctx, select_h2_alpn, nullptr);
 
+  configure_resumption(ctx);
+
+  // Kernel TLS: OpenSSL installs the record keys on the socket after the
+  // handshake when the kernel supports the negotiated cipher, and silently
+  // stays in user space otherwise.
+  if (ktls_) {
+    SSL_CTX_set_options(ctx, SSL_OP_ENABLE_KTLS);
+  }
+
   std::cerr << "✓ neonsignal->CertManager: loaded certificate for " << bundle.domain << '\n';
   return true;
 }
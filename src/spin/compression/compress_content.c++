@@ -0,0 +1,124 @@
+#include "spin/compression.h++"
+
+#include <zlib.h>
+
+#ifdef NEONSIGNAL_HAVE_BROTLI
+#include <brotli/encode.h>
+#endif
+#ifdef NEONSIGNAL_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace neonsignal {
+
+namespace {
+
+// Runtime variants are built on the worker pool, where they queue with
+// Database queries, so the levels favour speed over ratio. Deploys that want
+// maximum compression can ship .br/.gz/.zst siblings instead.
+constexpr int kGzipLevel = 6;
+constexpr int kGzipMemLevel = 8;
+constexpr int kBrotliQuality = 5;
+constexpr int kZstdLevel = 3;
+
+std::optional<std::vector<std::uint8_t>> gzip(std::span<const std::uint8_t> input) {
+  z_stream zs{};
+  // 15 window bits + 16 selects the gzip wrapper.
+  if (deflateInit2(&zs, kGzipLevel, Z_DEFLATED, 15 + 16, kGzipMemLevel,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    return std::nullopt;
+  }
+
+  std::vector<std::uint8_t> out(deflateBound(&zs, static_cast<uLong>(input.size())));
+  zs.next_in = const_cast<Bytef *>(input.data());
+  zs.avail_in = static_cast<uInt>(input.size());
+  zs.next_out = out.data();
+  zs.avail_out = static_cast<uInt>(out.size());
+
+  const int rc = deflate(&zs, Z_FINISH);
+  const auto written = zs.total_out;
+  deflateEnd(&zs);
+  if (rc != Z_STREAM_END) {
+    return std::nullopt;
+  }
+  out.resize(written);
+  return out;
+}
+
+#ifdef NEONSIGNAL_HAVE_BROTLI
+std::optional<std::vector<std::uint8_t>> brotli(std::span<const std::uint8_t> input) {
+  std::size_t out_size = BrotliEncoderMaxCompressedSize(input.size());
+  if (out_size == 0) {
+    return std::nullopt;
+  }
+  std::vector<std::uint8_t> out(out_size);
+  if (BrotliEncoderCompress(kBrotliQuality, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_GENERIC,
+                            input.size(), input.data(), &out_size, out.data()) != BROTLI_TRUE) {
+    return std::nullopt;
+  }
+  out.resize(out_size);
+  return out;
+}
+#endif
+
+#ifdef NEONSIGNAL_HAVE_ZSTD
+std::optional<std::vector<std::uint8_t>> zstd(std::span<const std::uint8_t> input) {
+  std::vector<std::uint8_t> out(ZSTD_compressBound(input.size()));
+  const std::size_t written =
+      ZSTD_compress(out.data(), out.size(), input.data(), input.size(), kZstdLevel);
+  if (ZSTD_isError(written)) {
+    return std::nullopt;
+  }
+  out.resize(written);
+  return out;
+}
+#endif
+
+} // namespace
+
+bool can_compress(ContentEncoding encoding) {
+  switch (encoding) {
+  case ContentEncoding::gzip:
+    return true;
+  case ContentEncoding::br:
+#ifdef NEONSIGNAL_HAVE_BROTLI
+    return true;
+#else
+    return false;
+#endif
+  case ContentEncoding::zstd:
+#ifdef NEONSIGNAL_HAVE_ZSTD
+    return true;
+#else
+    return false;
+#endif
+  case ContentEncoding::identity:
+    break;
+  }
+  return false;
+}
+
+std::optional<std::vector<std::uint8_t>> compress_content(ContentEncoding encoding,
+                                                          std::span<const std::uint8_t> input) {
+  switch (encoding) {
+  case ContentEncoding::gzip:
+    return gzip(input);
+  case ContentEncoding::br:
+#ifdef NEONSIGNAL_HAVE_BROTLI
+    return brotli(input);
+#else
+    break;
+#endif
+  case ContentEncoding::zstd:
+#ifdef NEONSIGNAL_HAVE_ZSTD
+    return zstd(input);
+#else
+    break;
+#endif
+  case ContentEncoding::identity:
+    break;
+  }
+  return std::nullopt;
+}
+
+} // namespace neonsignal
@@ -0,0 +1,33 @@
+#include "spin/compression.h++"
+
+namespace neonsignal {
+
+std::string_view content_encoding_token(ContentEncoding encoding) {
+  switch (encoding) {
+  case ContentEncoding::gzip:
+    return "gzip";
+  case ContentEncoding::br:
+    return "br";
+  case ContentEncoding::zstd:
+    return "zstd";
+  case ContentEncoding::identity:
+    break;
+  }
+  return "identity";
+}
+
+std::string_view content_encoding_suffix(ContentEncoding encoding) {
+  switch (encoding) {
+  case ContentEncoding::gzip:
+    return ".gz";
+  case ContentEncoding::br:
+    return ".br";
+  case ContentEncoding::zstd:
+    return ".zst";
+  case ContentEncoding::identity:
+    break;
+  }
+  return {};
+}
+
+} // namespace neonsignal
@@ -0,0 +1,27 @@
+#include "spin/compression.h++"
+
+#include <array>
+
+namespace neonsignal {
+
+bool is_compressible_mime(std::string_view mime_type) {
+  static constexpr std::array<std::string_view, 7> kCompressible = {
+      "application/javascript", "application/json", "application/xml", "application/wasm",
+      "image/svg+xml",          "image/x-icon",     "application/manifest+json",
+  };
+
+  if (auto params = mime_type.find(';'); params != std::string_view::npos) {
+    mime_type = mime_type.substr(0, params);
+  }
+  if (mime_type.starts_with("text/")) {
+    return true;
+  }
+  for (auto candidate : kCompressible) {
+    if (mime_type == candidate) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace neonsignal
@@ -0,0 +1,76 @@
+#include "spin/compression.h++"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace neonsignal {
+
+namespace {
+
+std::string_view trim(std::string_view s) {
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+bool is_zero_qvalue(std::string_view params) {
+  // params looks like ";q=0" / "; q=0.000" / ";level=1;q=0"
+  while (!params.empty()) {
+    auto semi = params.find(';');
+    auto param = trim(params.substr(0, semi));
+    params = semi == std::string_view::npos ? std::string_view{} : params.substr(semi + 1);
+    if (param.size() >= 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+      auto value = param.substr(2);
+      return !value.empty() && std::all_of(value.begin(), value.end(), [](char c) {
+        return c == '0' || c == '.';
+      });
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+EncodingMask parse_accept_encoding(std::string_view header) {
+  EncodingMask mask = kIdentityOnly;
+  bool wildcard = false;
+
+  while (!header.empty()) {
+    auto comma = header.find(',');
+    auto item = header.substr(0, comma);
+    header = comma == std::string_view::npos ? std::string_view{} : header.substr(comma + 1);
+
+    auto semi = item.find(';');
+    auto coding = trim(item.substr(0, semi));
+    if (coding.empty() ||
+        (semi != std::string_view::npos && is_zero_qvalue(item.substr(semi + 1)))) {
+      continue;
+    }
+
+    std::string lower(coding);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "gzip" || lower == "x-gzip") {
+      mask |= encoding_bit(ContentEncoding::gzip);
+    } else if (lower == "br") {
+      mask |= encoding_bit(ContentEncoding::br);
+    } else if (lower == "zstd") {
+      mask |= encoding_bit(ContentEncoding::zstd);
+    } else if (lower == "*") {
+      wildcard = true;
+    }
+  }
+
+  if (wildcard) {
+    mask |= encoding_bit(ContentEncoding::gzip) | encoding_bit(ContentEncoding::br) |
+            encoding_bit(ContentEncoding::zstd);
+  }
+  return mask;
+}
+
+} // namespace neonsignal
@@ -4,9 +4,11 @@
 #include <openssl/rand.h>
 
 #include <array>
+#include <charconv>
 #include <chrono>
 #include <algorithm>
 #include <filesystem>
+#include <iostream>
 
 namespace neonsignal {
 
@@ -23,6 +25,15 @@ std::string codex_run_to_json(const CodexRun& run);
 std::optional<CodexRun> codex_run_from_json(std::string_view json);
 std::string mail_submission_to_json(const MailSubmission& submission);
 std::optional<MailSubmission> mail_submission_from_json(std::string_view json);
+bool is_record(std::string_view value);
+std::string user_to_record(const User& user);
+std::optional<User> user_from_record(std::string_view value);
+std::string session_to_record(const Session& session);
+std::optional<Session> session_from_record(std::string_view value);
+std::string verification_to_record(const Verification& v);
+std::optional<Verification> verification_from_record(std::string_view value);
+std::string codex_to_record(const CodexRecord& record);
+std::optional<CodexRecord> codex_from_record(std::string_view value);
 } // namespace db
 
 namespace {
@@ -63,6 +74,69 @@ std::string sha256_hex(std::span<const std::uint8_t> data) {
   return out;
 }
 
+constexpr std::string_view kSchemaVersion = "2";
+constexpr std::string_view kUserCountKey = "user_count";
+
+// created_at and the numeric codex id, big-endian, so byte order is time order
+std::string codex_index_key(std::time_t created_at, std::string_view id) {
+  std::uint64_t numeric_id = 0;
+  std::from_chars(id.data(), id.data() + id.size(), numeric_id);
+  std::string key(16, '\0');
+  auto created = static_cast<std::uint64_t>(created_at);
+  for (int i = 0; i < 8; ++i) {
+    key[static_cast<std::size_t>(i)] = static_cast<char>(created >> (56 - 8 * i));
+    key[static_cast<std::size_t>(8 + i)] = static_cast<char>(numeric_id >> (56 - 8 * i));
+  }
+  return key;
+}
+
+// Page cursors are "<created_at>-<id>" of the last record on the page.
+std::optional<std::string> codex_cursor_key(std::string_view cursor) {
+  auto dash = cursor.find('-');
+  std::uint64_t created = 0;
+  if (dash == std::string_view::npos ||
+      std::from_chars(cursor.data(), cursor.data() + dash, created).ec != std::errc{}) {
+    return std::nullopt;
+  }
+  return codex_index_key(static_cast<std::time_t>(created), cursor.substr(dash + 1));
+}
+
+std::uint64_t read_counter(mdbx::txn& txn, mdbx::map_handle map, std::string_view key) {
+  auto value = txn.get(map, mdbx::slice(key.data(), key.size()), mdbx::slice::invalid());
+  std::uint64_t count = 0;
+  if (value.is_valid()) {
+    auto view = slice_to_view(value);
+    std::from_chars(view.data(), view.data() + view.size(), count);
+  }
+  return count;
+}
+
+void write_counter(mdbx::txn& txn, mdbx::map_handle map, std::string_view key,
+                   std::uint64_t count) {
+  auto text = std::to_string(count);
+  txn.put(map, mdbx::slice(key.data(), key.size()), mdbx::slice(text), mdbx::put_mode::upsert);
+}
+
+// Rewrite every JSON value of `map` in the binary record format.
+template <typename Decode, typename Encode>
+std::size_t reencode_map(mdbx::txn& txn, mdbx::map_handle map, Decode decode, Encode encode) {
+  std::vector<std::pair<std::string, std::string>> rewritten;
+  auto cursor = txn.open_cursor(map);
+  for (auto kv = cursor.to_first(false); kv; kv = cursor.to_next(false)) {
+    auto value = slice_to_view(kv.value);
+    if (db::is_record(value)) {
+      continue;
+    }
+    if (auto decoded = decode(value)) {
+      rewritten.emplace_back(std::string(slice_to_view(kv.key)), encode(*decoded));
+    }
+  }
+  for (const auto& [key, value] : rewritten) {
+    txn.put(map, mdbx::slice(key), mdbx::slice(value), mdbx::put_mode::upsert);
+  }
+  return rewritten.size();
+}
+
 } // namespace
 
 Database::Database(std::string_view path)
@@ -78,6 +152,7 @@ Database::Database(std::string_view path)
   operate_params.reclaiming.coalesce = true;
   env_ = mdbx::env_managed(std::string(path), create_params, operate_params);
   open_maps_();
+  migrate_();
 }
 
 void Database::open_maps_() {
@@ -90,6 +165,7 @@ void Database::open_maps_() {
   verifications_map_ = txn.create_map("verifications");
   config_map_ = txn.create_map("config");
   codex_meta_map_ = txn.create_map("codex_meta");
+  codex_by_created_map_ = txn.create_map("codex_by_created");
   codex_payloads_map_ = txn.create_map("codex_payloads");
   codex_images_map_ = txn.create_map("codex_images");
   codex_runs_map_ = txn.create_map("codex_runs");
@@ -101,6 +177,55 @@ void Database::open_maps_() {
   txn.commit();
 }
 
+void Database::migrate_() {
+  auto txn = env_.start_write();
+  auto version = txn.get(config_map_, mdbx::slice("schema_version"), mdbx::slice::invalid());
+  if (version.is_valid() && slice_to_view(version) == kSchemaVersion) {
+    return;
+  }
+
+  std::size_t converted = 0;
+  converted += reencode_map(txn, users_map_, db::user_from_record, db::user_to_record);
+  converted += reencode_map(txn, sessions_map_, db::session_from_record, db::session_to_record);
+  converted += reencode_map(txn, verifications_map_, db::verification_from_record,
+                            db::verification_to_record);
+  converted += reencode_map(txn, codex_meta_map_, db::codex_from_record, db::codex_to_record);
+
+  // created_at index for codex listing
+  std::size_t indexed = 0;
+  auto cursor = txn.open_cursor(codex_meta_map_);
+  for (auto kv = cursor.to_first(false); kv; kv = cursor.to_next(false)) {
+    auto record = db::codex_from_record(slice_to_view(kv.value));
+    if (!record) {
+      continue;
+    }
+    auto id = slice_to_view(kv.key);
+    auto key = codex_index_key(record->created_at, id);
+    txn.put(codex_by_created_map_, mdbx::slice(key), mdbx::slice(id.data(), id.size()),
+            mdbx::put_mode::upsert);
+    ++indexed;
+  }
+
+  // Maintained from here on by the user creation paths
+  std::uint64_t users = 0;
+  auto users_cursor = txn.open_cursor(users_map_);
+  for (auto kv = users_cursor.to_first(false); kv; kv = users_cursor.to_next(false)) {
+    ++users;
+  }
+  write_counter(txn, config_map_, kUserCountKey, users);
+
+  txn.put(config_map_, mdbx::slice("schema_version"),
+          mdbx::slice(kSchemaVersion.data(), kSchemaVersion.size()), mdbx::put_mode::upsert);
+  txn.commit();
+  std::cerr << "• db: migrated to schema " << kSchemaVersion << " (" << converted
+            << " record(s) re-encoded, " << indexed << " codex entr(ies) indexed, " << users
+            << " user(s))\n";
+}
+
+void Database::log_query_error_(const std::exception& e) {
+  std::cerr << "✗ db: async query failed: " << e.what() << '\n';
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // New user registration flow
 // ─────────────────────────────────────────────────────────────────────────────
@@ -143,13 +268,15 @@ std::optional<User> Database::create_user_pending(std::string_view email,
 
   // Store user by ID
   auto id_key = std::to_string(next_id);
-  auto json = db::user_to_json(user);
+  auto encoded = db::user_to_record(user);
   txn.put(users_map_, mdbx::slice(id_key.data(), id_key.size()),
-          mdbx::slice(json), mdbx::put_mode::insert_unique);
+          mdbx::slice(encoded), mdbx::put_mode::insert_unique);
 
   // Store email → user_id index
   txn.put(emails_map_, mdbx::slice(email.data(), email.size()),
           mdbx::slice(id_key.data(), id_key.size()), mdbx::put_mode::insert_unique);
+  write_counter(txn, config_map_, kUserCountKey,
+                read_counter(txn, config_map_, kUserCountKey) + 1);
 
   txn.commit();
   return user;
@@ -168,7 +295,7 @@ std::optional<User> Database::find_user_by_email(std::string_view email) {
   if (!user_data.is_valid()) {
     return std::nullopt;
   }
-  return db::user_from_json(slice_to_view(user_data));
+  return db::user_from_record(slice_to_view(user_data));
 }
 
 std::optional<User> Database::find_user_by_id(std::uint64_t user_id) {
@@ -179,7 +306,7 @@ std::optional<User> Database::find_user_by_id(std::uint64_t user_id) {
   if (!user_data.is_valid()) {
     return std::nullopt;
   }
-  return db::user_from_json(slice_to_view(user_data));
+  return db::user_from_record(slice_to_view(user_data));
 }
 
 bool Database::set_user_verified(std::uint64_t user_id) {
@@ -190,14 +317,14 @@ bool Database::set_user_verified(std::uint64_t user_id) {
   if (!user_data.is_valid()) {
     return false;
   }
-  auto user = db::user_from_json(slice_to_view(user_data));
+  auto user = db::user_from_record(slice_to_view(user_data));
   if (!user) {
     return false;
   }
   user->verified = true;
-  auto json = db::user_to_json(*user);
+  auto encoded = db::user_to_record(*user);
   txn.put(users_map_, mdbx::slice(id_key.data(), id_key.size()),
-          mdbx::slice(json), mdbx::put_mode::update);
+          mdbx::slice(encoded), mdbx::put_mode::update);
   txn.commit();
   return true;
 }
@@ -212,7 +339,7 @@ bool Database::set_user_credential(std::uint64_t user_id,
   if (!user_data.is_valid()) {
     return false;
   }
-  auto user = db::user_from_json(slice_to_view(user_data));
+  auto user = db::user_from_record(slice_to_view(user_data));
   if (!user) {
     return false;
   }
@@ -220,9 +347,9 @@ bool Database::set_user_credential(std::uint64_t user_id,
   user->credential_id.assign(credential_id.begin(), credential_id.end());
   user->public_key.assign(public_key.begin(), public_key.end());
 
-  auto json = db::user_to_json(*user);
+  auto encoded = db::user_to_record(*user);
   txn.put(users_map_, mdbx::slice(id_key.data(), id_key.size()),
-          mdbx::slice(json), mdbx::put_mode::update);
+          mdbx::slice(encoded), mdbx::put_mode::update);
 
   // Add credential_id → user_id index for WebAuthn login
   txn.put(credentials_map_, mdbx::slice(credential_id.data(), credential_id.size()),
@@ -234,14 +361,7 @@ bool Database::set_user_credential(std::uint64_t user_id,
 
 std::uint64_t Database::count_users() {
   auto txn = env_.start_read();
-  auto cursor = txn.open_cursor(users_map_);
-  std::uint64_t count = 0;
-
-  for (auto it = cursor.to_first(false); it; it = cursor.to_next(false)) {
-    ++count;
-  }
-
-  return count;
+  return read_counter(txn, config_map_, kUserCountKey);
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -281,12 +401,14 @@ std::optional<User> Database::create_user(std::string_view username,
   user.created_at = std::time(nullptr);
   user.last_login = 0;
 
-  auto json = db::user_to_json(user);
+  auto encoded = db::user_to_record(user);
   txn.put(users_map_, mdbx::slice(user.credential_id.data(), user.credential_id.size()),
-          mdbx::slice(json), mdbx::put_mode::insert_unique);
+          mdbx::slice(encoded), mdbx::put_mode::insert_unique);
   txn.put(usernames_map_, mdbx::slice(user.email.data(), user.email.size()),
           mdbx::slice(user.credential_id.data(), user.credential_id.size()),
           mdbx::put_mode::insert_unique);
+  write_counter(txn, config_map_, kUserCountKey,
+                read_counter(txn, config_map_, kUserCountKey) + 1);
   txn.commit();
   return user;
 }
@@ -300,7 +422,7 @@ std::optional<User> Database::find_user_by_credential(
   if (!value.is_valid()) {
     return std::nullopt;
   }
-  auto user = db::user_from_json(slice_to_view(value));
+  auto user = db::user_from_record(slice_to_view(value));
   if (!user) {
     return std::nullopt;
   }
@@ -327,11 +449,17 @@ std::vector<User> Database::list_users() {
   auto txn = env_.start_read();
   auto cursor = txn.open_cursor(users_map_);
   for (auto kv = cursor.to_first(false); kv; kv = cursor.to_next(false)) {
-    auto user = db::user_from_json(slice_to_view(kv.value));
+    auto user = db::user_from_record(slice_to_view(kv.value));
     if (!user) {
       continue;
     }
-    user->credential_id = slice_to_bytes(kv.key);
+    if (!user->has_credential()) {
+      // Legacy records are keyed by credential id; pending users have none.
+      auto key = slice_to_view(kv.key);
+      if (key.find_first_not_of("0123456789") != std::string_view::npos) {
+        user->credential_id = slice_to_bytes(kv.key);
+      }
+    }
     out.push_back(std::move(*user));
   }
   return out;
@@ -359,15 +487,15 @@ bool Database::update_sign_count(std::span<const std::uint8_t> credential_id,
     if (!value.is_valid()) {
       return false;
     }
-    auto user = db::user_from_json(slice_to_view(value));
+    auto user = db::user_from_record(slice_to_view(value));
     if (!user) {
       return false;
     }
     user->sign_count = sign_count;
     user->last_login = std::time(nullptr);
-    auto json = db::user_to_json(*user);
+    auto encoded = db::user_to_record(*user);
     txn.put(users_map_, mdbx::slice(credential_id.data(), credential_id.size()),
-            mdbx::slice(json), mdbx::put_mode::update);
+            mdbx::slice(encoded), mdbx::put_mode::update);
     txn.commit();
     return true;
   }
@@ -379,15 +507,15 @@ bool Database::update_sign_count(std::span<const std::uint8_t> credential_id,
   if (!value.is_valid()) {
     return false;
   }
-  auto user = db::user_from_json(slice_to_view(value));
+  auto user = db::user_from_record(slice_to_view(value));
   if (!user) {
     return false;
   }
   user->sign_count = sign_count;
   user->last_login = std::time(nullptr);
-  auto json = db::user_to_json(*user);
+  auto encoded = db::user_to_record(*user);
   txn.put(users_map_, mdbx::slice(user_id_str.data(), user_id_str.size()),
-          mdbx::slice(json), mdbx::put_mode::update);
+          mdbx::slice(encoded), mdbx::put_mode::update);
   txn.commit();
   return true;
 }
@@ -404,10 +532,10 @@ bool Database::store_verification(std::span<const std::uint8_t> token_hash,
   v.expires_at = std::time(nullptr) + ttl.count();
   v.used_at = 0;
 
-  auto json = db::verification_to_json(v);
+  auto encoded = db::verification_to_record(v);
   auto txn = env_.start_write();
   txn.put(verifications_map_, mdbx::slice(token_hash.data(), token_hash.size()),
-          mdbx::slice(json), mdbx::put_mode::upsert);
+          mdbx::slice(encoded), mdbx::put_mode::upsert);
   txn.commit();
   return true;
 }
@@ -420,7 +548,7 @@ std::optional<Verification> Database::find_verification(std::span<const std::uin
   if (!value.is_valid()) {
     return std::nullopt;
   }
-  return db::verification_from_json(slice_to_view(value));
+  return db::verification_from_record(slice_to_view(value));
 }
 
 bool Database::mark_verification_used(std::span<const std::uint8_t> token_hash) {
@@ -431,14 +559,14 @@ bool Database::mark_verification_used(std::span<const std::uint8_t> token_hash)
   if (!value.is_valid()) {
     return false;
   }
-  auto v = db::verification_from_json(slice_to_view(value));
+  auto v = db::verification_from_record(slice_to_view(value));
   if (!v) {
     return false;
   }
   v->used_at = std::time(nullptr);
-  auto json = db::verification_to_json(*v);
+  auto encoded = db::verification_to_record(*v);
   txn.put(verifications_map_, mdbx::slice(token_hash.data(), token_hash.size()),
-          mdbx::slice(json), mdbx::put_mode::update);
+          mdbx::slice(encoded), mdbx::put_mode::update);
   txn.commit();
   return true;
 }
@@ -449,7 +577,7 @@ std::size_t Database::cleanup_expired_verifications() {
   auto cursor = txn.open_cursor(verifications_map_);
   auto now = std::time(nullptr);
   for (auto kv = cursor.to_first(false); kv; kv = cursor.to_next(false)) {
-    auto v = db::verification_from_json(slice_to_view(kv.value));
+    auto v = db::verification_from_record(slice_to_view(kv.value));
     if (!v) {
       continue;
     }
@@ -477,10 +605,10 @@ std::string Database::create_session(std::uint64_t user_id, std::string_view use
   session.state = std::string(state);
   session.created_at = std::time(nullptr);
   session.expires_at = session.created_at + ttl.count();
-  auto json = db::session_to_json(session);
+  auto encoded = db::session_to_record(session);
   auto txn = env_.start_write();
   txn.put(sessions_map_, mdbx::slice(session_id.data(), session_id.size()),
-          mdbx::slice(json), mdbx::put_mode::upsert);
+          mdbx::slice(encoded), mdbx::put_mode::upsert);
   txn.commit();
   return session_id;
 }
@@ -495,7 +623,7 @@ std::optional<Session> Database::validate_session(std::string_view session_id) {
     if (!value.is_valid()) {
       return std::nullopt;
     }
-    session = db::session_from_json(slice_to_view(value));
+    session = db::session_from_record(slice_to_view(value));
     if (!session) {
       return std::nullopt;
     }
@@ -516,15 +644,15 @@ bool Database::update_session_expiry(std::string_view session_id, std::chrono::s
   if (!value.is_valid()) {
     return false;
   }
-  auto session = db::session_from_json(slice_to_view(value));
+  auto session = db::session_from_record(slice_to_view(value));
   if (!session) {
     return false;
   }
   session->id = std::string(session_id);
   session->expires_at = std::time(nullptr) + ttl.count();
-  auto json = db::session_to_json(*session);
+  auto encoded = db::session_to_record(*session);
   txn.put(sessions_map_, mdbx::slice(session_id.data(), session_id.size()),
-          mdbx::slice(json), mdbx::put_mode::upsert);
+          mdbx::slice(encoded), mdbx::put_mode::upsert);
   txn.commit();
   return true;
 }
@@ -538,16 +666,16 @@ bool Database::upgrade_session_state(std::string_view session_id,
   if (!value.is_valid()) {
     return false;
   }
-  auto session = db::session_from_json(slice_to_view(value));
+  auto session = db::session_from_record(slice_to_view(value));
   if (!session) {
     return false;
   }
   session->id = std::string(session_id);
   session->state = std::string(new_state);
   session->expires_at = std::time(nullptr) + new_ttl.count();
-  auto json = db::session_to_json(*session);
+  auto encoded = db::session_to_record(*session);
   txn.put(sessions_map_, mdbx::slice(session_id.data(), session_id.size()),
-          mdbx::slice(json), mdbx::put_mode::upsert);
+          mdbx::slice(encoded), mdbx::put_mode::upsert);
   txn.commit();
   return true;
 }
@@ -565,7 +693,7 @@ std::size_t Database::cleanup_expired_sessions() {
   auto cursor = txn.open_cursor(sessions_map_);
   auto now = std::time(nullptr);
   for (auto kv = cursor.to_first(false); kv; kv = cursor.to_next(false)) {
-    auto session = db::session_from_json(slice_to_view(kv.value));
+    auto session = db::session_from_record(slice_to_view(kv.value));
     if (!session) {
       continue;
     }
@@ -614,9 +742,12 @@ std::optional<CodexRecord> Database::store_codex_entry(
   record.image_meta = brief.image_meta;
   record.image_size = brief.image_bytes.size();
 
-  auto meta_json = db::codex_to_json(record);
+  auto encoded = db::codex_to_record(record);
   txn.put(codex_meta_map_, mdbx::slice(record.id.data(), record.id.size()),
-          mdbx::slice(meta_json), mdbx::put_mode::upsert);
+          mdbx::slice(encoded), mdbx::put_mode::upsert);
+  auto index_key = codex_index_key(record.created_at, record.id);
+  txn.put(codex_by_created_map_, mdbx::slice(index_key),
+          mdbx::slice(record.id.data(), record.id.size()), mdbx::put_mode::upsert);
   if (!payload.empty()) {
     txn.put(codex_payloads_map_, mdbx::slice(record.id.data(), record.id.size()),
             mdbx::slice(payload.data(), payload.size()), mdbx::put_mode::upsert);
@@ -641,7 +772,7 @@ std::optional<CodexRecord> Database::fetch_codex_record(std::string_view id) {
   if (!value.is_valid()) {
     return std::nullopt;
   }
-  auto record = db::codex_from_json(slice_to_view(value));
+  auto record = db::codex_from_record(slice_to_view(value));
   if (!record) {
     return std::nullopt;
   }
@@ -670,25 +801,47 @@ std::optional<std::vector<std::uint8_t>> Database::fetch_codex_image(std::string
 }
 
 std::vector<CodexRecord> Database::list_codex(std::size_t limit) {
-  std::vector<CodexRecord> out;
+  return list_codex_page(limit).items;
+}
+
+CodexPage Database::list_codex_page(std::size_t limit, std::string_view cursor) {
+  CodexPage page;
+  if (limit == 0) {
+    return page;
+  }
   auto txn = env_.start_read();
-  auto cursor = txn.open_cursor(codex_meta_map_);
-  for (auto kv = cursor.to_first(false); kv; kv = cursor.to_next(false)) {
-    auto record = db::codex_from_json(slice_to_view(kv.value));
+  auto index = txn.open_cursor(codex_by_created_map_);
+
+  // Newest first: start at the end, or just before the previous page's last key.
+  auto kv = index.to_last(false);
+  if (!cursor.empty()) {
+    auto key = codex_cursor_key(cursor);
+    if (!key) {
+      return page;
+    }
+    kv = index.lower_bound(mdbx::slice(*key), false) ? index.to_previous(false)
+                                                     : index.to_last(false);
+  }
+
+  for (; kv && page.items.size() < limit; kv = index.to_previous(false)) {
+    auto id = slice_to_view(kv.value);
+    auto value = txn.get(codex_meta_map_, mdbx::slice(id.data(), id.size()),
+                         mdbx::slice::invalid());
+    if (!value.is_valid()) {
+      continue;
+    }
+    auto record = db::codex_from_record(slice_to_view(value));
     if (!record) {
       continue;
     }
-    record->id = std::string(slice_to_view(kv.key));
-    out.push_back(std::move(*record));
+    record->id = std::string(id);
+    page.items.push_back(std::move(*record));
   }
-  std::sort(out.begin(), out.end(),
-            [](const CodexRecord& a, const CodexRecord& b) {
-              return a.created_at > b.created_at;
-            });
-  if (out.size() > limit) {
-    out.resize(limit);
+  if (kv && !page.items.empty()) {
+    const auto& last = page.items.back();
+    page.next_cursor = std::to_string(static_cast<std::uint64_t>(last.created_at)) + "-" + last.id;
   }
-  return out;
+  return page;
 }
 
 std::optional<CodexRun> Database::create_codex_run(std::string_view brief_id,
@@ -0,0 +1,237 @@
+#include "spin/database.h++"
+
+#include <cstdint>
+#include <string>
+
+namespace neonsignal::db {
+
+std::optional<User> user_from_json(std::string_view json);
+std::optional<Session> session_from_json(std::string_view json);
+std::optional<Verification> verification_from_json(std::string_view json);
+std::optional<CodexRecord> codex_from_json(std::string_view json);
+
+namespace {
+
+// Binary records start with a byte no JSON document starts with, followed by
+// the format version. Integers are LEB128 varints, strings and byte arrays
+// are varint-length-prefixed.
+constexpr std::uint8_t kRecordMagic = 0xB1;
+constexpr std::uint8_t kRecordVersion = 1;
+
+class RecordWriter {
+public:
+  RecordWriter() {
+    out_.push_back(static_cast<char>(kRecordMagic));
+    out_.push_back(static_cast<char>(kRecordVersion));
+  }
+
+  void u64(std::uint64_t value) {
+    while (value >= 0x80) {
+      out_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    out_.push_back(static_cast<char>(value));
+  }
+
+  void str(std::string_view value) {
+    u64(value.size());
+    out_.append(value);
+  }
+
+  void bytes(std::span<const std::uint8_t> value) {
+    u64(value.size());
+    out_.append(reinterpret_cast<const char*>(value.data()), value.size());
+  }
+
+  std::string take() { return std::move(out_); }
+
+private:
+  std::string out_;
+};
+
+// Reads fields in order; any underflow marks the whole record invalid.
+class RecordReader {
+public:
+  explicit RecordReader(std::string_view in) : in_(in) {
+    ok_ = in_.size() >= 2 && static_cast<std::uint8_t>(in_[0]) == kRecordMagic &&
+          static_cast<std::uint8_t>(in_[1]) <= kRecordVersion;
+    pos_ = 2;
+  }
+
+  std::uint64_t u64() {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; ok_ && shift < 64; shift += 7) {
+      if (pos_ >= in_.size()) {
+        break;
+      }
+      auto byte = static_cast<std::uint8_t>(in_[pos_++]);
+      value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    ok_ = false;
+    return 0;
+  }
+
+  std::string str() {
+    auto len = u64();
+    if (!ok_ || len > in_.size() - pos_) {
+      ok_ = false;
+      return {};
+    }
+    std::string value(in_.substr(pos_, len));
+    pos_ += len;
+    return value;
+  }
+
+  std::vector<std::uint8_t> bytes() {
+    auto value = str();
+    return std::vector<std::uint8_t>(value.begin(), value.end());
+  }
+
+  [[nodiscard]] bool ok() const { return ok_; }
+
+private:
+  std::string_view in_;
+  std::size_t pos_{0};
+  bool ok_{false};
+};
+
+} // namespace
+
+bool is_record(std::string_view value) {
+  return !value.empty() && static_cast<std::uint8_t>(value[0]) == kRecordMagic;
+}
+
+std::string user_to_record(const User& user) {
+  RecordWriter w;
+  w.u64(user.id);
+  w.str(user.email);
+  w.str(user.display_name);
+  w.u64(user.verified ? 1 : 0);
+  w.bytes(user.credential_id);
+  w.bytes(user.public_key);
+  w.u64(user.sign_count);
+  w.u64(static_cast<std::uint64_t>(user.created_at));
+  w.u64(static_cast<std::uint64_t>(user.last_login));
+  return w.take();
+}
+
+std::optional<User> user_from_record(std::string_view value) {
+  if (!is_record(value)) {
+    return user_from_json(value);
+  }
+  RecordReader r(value);
+  User user;
+  user.id = r.u64();
+  user.email = r.str();
+  user.display_name = r.str();
+  user.verified = r.u64() != 0;
+  user.credential_id = r.bytes();
+  user.public_key = r.bytes();
+  user.sign_count = static_cast<std::uint32_t>(r.u64());
+  user.created_at = static_cast<std::time_t>(r.u64());
+  user.last_login = static_cast<std::time_t>(r.u64());
+  if (!r.ok() || user.email.empty()) {
+    return std::nullopt;
+  }
+  return user;
+}
+
+std::string session_to_record(const Session& session) {
+  RecordWriter w;
+  w.u64(session.user_id);
+  w.str(session.user);
+  w.str(session.state);
+  w.u64(static_cast<std::uint64_t>(session.created_at));
+  w.u64(static_cast<std::uint64_t>(session.expires_at));
+  return w.take();
+}
+
+std::optional<Session> session_from_record(std::string_view value) {
+  if (!is_record(value)) {
+    return session_from_json(value);
+  }
+  RecordReader r(value);
+  Session session;
+  session.user_id = r.u64();
+  session.user = r.str();
+  session.state = r.str();
+  session.created_at = static_cast<std::time_t>(r.u64());
+  session.expires_at = static_cast<std::time_t>(r.u64());
+  if (!r.ok() || session.user.empty()) {
+    return std::nullopt;
+  }
+  return session;
+}
+
+std::string verification_to_record(const Verification& v) {
+  RecordWriter w;
+  w.u64(v.user_id);
+  w.u64(static_cast<std::uint64_t>(v.expires_at));
+  w.u64(static_cast<std::uint64_t>(v.used_at));
+  return w.take();
+}
+
+std::optional<Verification> verification_from_record(std::string_view value) {
+  if (!is_record(value)) {
+    return verification_from_json(value);
+  }
+  RecordReader r(value);
+  Verification v;
+  v.user_id = r.u64();
+  v.expires_at = static_cast<std::time_t>(r.u64());
+  v.used_at = static_cast<std::time_t>(r.u64());
+  if (!r.ok()) {
+    return std::nullopt;
+  }
+  return v;
+}
+
+std::string codex_to_record(const CodexRecord& record) {
+  RecordWriter w;
+  w.str(record.id);
+  w.str(record.content_type);
+  w.str(record.sha256);
+  w.u64(record.size);
+  w.u64(static_cast<std::uint64_t>(record.created_at));
+  w.str(record.title);
+  w.str(record.meta_tags);
+  w.str(record.description);
+  w.str(record.file_refs);
+  w.str(record.image_name);
+  w.str(record.image_type);
+  w.str(record.image_alt);
+  w.str(record.image_meta);
+  w.u64(record.image_size);
+  return w.take();
+}
+
+std::optional<CodexRecord> codex_from_record(std::string_view value) {
+  if (!is_record(value)) {
+    return codex_from_json(value);
+  }
+  RecordReader r(value);
+  CodexRecord record;
+  record.id = r.str();
+  record.content_type = r.str();
+  record.sha256 = r.str();
+  record.size = r.u64();
+  record.created_at = static_cast<std::time_t>(r.u64());
+  record.title = r.str();
+  record.meta_tags = r.str();
+  record.description = r.str();
+  record.file_refs = r.str();
+  record.image_name = r.str();
+  record.image_type = r.str();
+  record.image_alt = r.str();
+  record.image_meta = r.str();
+  record.image_size = r.u64();
+  if (!r.ok()) {
+    return std::nullopt;
+  }
+  return record;
+}
+
+} // namespace neonsignal::db
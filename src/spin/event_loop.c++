@@ -1,14 +1,38 @@
 #include "spin/event_loop.h++"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
 namespace neonsignal {
 
-EventLoop::EventLoop() : backend_(create_event_loop_backend()) {}
+EventLoop::EventLoop() : backend_(create_event_loop_backend()) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    throw std::runtime_error("failed to create event loop wake pipe");
+  }
+  for (int fd : fds) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+  }
+  wake_read_fd_ = fds[0];
+  wake_write_fd_ = fds[1];
+  // Registered with the backend directly so it is not counted as a client fd.
+  backend_->add_fd(wake_read_fd_, EventMask::Read, [this](std::uint32_t) { run_posted_(); });
+}
 
 EventLoop::~EventLoop() {
   stop();
   if (backend_) {
     backend_->cleanup();
   }
+  if (wake_read_fd_ != -1) {
+    close(wake_read_fd_);
+  }
+  if (wake_write_fd_ != -1) {
+    close(wake_write_fd_);
+  }
 }
 
 } // namespace neonsignal
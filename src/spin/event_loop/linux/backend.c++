@@ -166,15 +166,21 @@ public:
   }
 
   void cancel_timer(int timer_id) override {
-    std::lock_guard lock(mutex_);
-    auto it = timers_.find(timer_id);
-    if (it != timers_.end()) {
-      if (it->second.fd != -1) {
-        remove_fd(it->second.fd);
-        close(it->second.fd);
+    int fd = -1;
+    {
+      std::lock_guard lock(mutex_);
+      auto it = timers_.find(timer_id);
+      if (it == timers_.end()) {
+        return;
       }
+      fd = it->second.fd;
       timers_.erase(it);
     }
+    // remove_fd takes mutex_ itself; timers may be cancelled from another reactor.
+    if (fd != -1) {
+      remove_fd(fd);
+      close(fd);
+    }
   }
 
   int poll(int timeout_ms) override {
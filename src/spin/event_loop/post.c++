@@ -0,0 +1,38 @@
+#include "spin/event_loop.h++"
+
+#include <unistd.h>
+
+#include <utility>
+
+namespace neonsignal {
+
+void EventLoop::post(std::function<void()> task) {
+  bool wake = false;
+  {
+    std::lock_guard lock(posted_mutex_);
+    wake = posted_.empty();
+    posted_.push_back(std::move(task));
+  }
+  if (wake) {
+    // A full pipe already guarantees a pending wakeup.
+    char byte = 1;
+    [[maybe_unused]] auto n = write(wake_write_fd_, &byte, 1);
+  }
+}
+
+void EventLoop::run_posted_() {
+  char drain[64];
+  while (read(wake_read_fd_, drain, sizeof(drain)) > 0) {
+  }
+
+  std::vector<std::function<void()>> tasks;
+  {
+    std::lock_guard lock(posted_mutex_);
+    tasks.swap(posted_);
+  }
+  for (auto& task : tasks) {
+    task();
+  }
+}
+
+} // namespace neonsignal
@@ -5,8 +5,7 @@
 namespace neonsignal {
 
 void EventLoop::run() {
-  running_.store(true);
-
+  // running_ starts out true, so a stop() issued before run() is honoured.
   while (running_.load()) {
     int n = backend_->poll(500);  // 500ms timeout
     if (n == -1) {
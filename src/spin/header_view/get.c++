@@ -0,0 +1,37 @@
+#include "spin/header_view.h++"
+
+namespace neonsignal {
+
+std::optional<std::string_view> HeaderView::get(std::string_view name) const {
+  for (const auto& field : fields_) {
+    if (field.name == name) {
+      return field.value;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<std::string_view> HeaderView::cookie(std::string_view name) const {
+  for (const auto& field : fields_) {
+    if (field.name != "cookie") {
+      continue;
+    }
+    std::string_view rest = field.value;
+    while (!rest.empty()) {
+      auto semi = rest.find(';');
+      auto pair = rest.substr(0, semi);
+      rest = semi == std::string_view::npos ? std::string_view{} : rest.substr(semi + 1);
+
+      while (!pair.empty() && pair.front() == ' ') {
+        pair.remove_prefix(1);
+      }
+      auto eq = pair.find('=');
+      if (eq != std::string_view::npos && pair.substr(0, eq) == name) {
+        return pair.substr(eq + 1);
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace neonsignal
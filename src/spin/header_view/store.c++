@@ -0,0 +1,56 @@
+#include "spin/header_view.h++"
+
+#include <algorithm>
+#include <cstring>
+
+namespace neonsignal {
+
+void HeaderView::clear() {
+  method = path = authority = scheme = {};
+  fields_.clear();
+  chunk_index_ = 0;
+  chunk_used_ = 0;
+  oversized_.clear();
+  oversized_bytes_ = 0;
+}
+
+std::string_view HeaderView::store(const std::uint8_t* data, std::size_t len, bool lowercase) {
+  if (len == 0) {
+    return {};
+  }
+
+  char* dst = nullptr;
+  if (len > kChunkBytes) {
+    oversized_.push_back(std::make_unique<char[]>(len));
+    oversized_bytes_ += len;
+    dst = oversized_.back().get();
+  } else {
+    if (chunks_.empty() || kChunkBytes - chunk_used_ < len) {
+      if (!chunks_.empty()) {
+        ++chunk_index_;
+        chunk_used_ = 0;
+      }
+      if (chunk_index_ == chunks_.size()) {
+        chunks_.push_back(std::make_unique<char[]>(kChunkBytes));
+      }
+    }
+    dst = chunks_[chunk_index_].get() + chunk_used_;
+    chunk_used_ += len;
+  }
+
+  if (lowercase) {
+    // RFC 9113 requires lowercase names; fold instead of rejecting.
+    std::transform(data, data + len, dst, [](std::uint8_t c) {
+      return static_cast<char>(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+    });
+  } else {
+    std::memcpy(dst, data, len);
+  }
+  return {dst, len};
+}
+
+std::size_t HeaderView::arena_capacity() const {
+  return chunks_.size() * kChunkBytes + oversized_bytes_;
+}
+
+} // namespace neonsignal
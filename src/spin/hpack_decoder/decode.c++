@@ -1,21 +1,18 @@
 #include "spin/hpack_decoder.h++"
 
-#include <optional>
-#include <string>
-#include <vector>
-#include <algorithm>
-#include <cctype>
+#include <span>
+#include <string_view>
 
 namespace neonsignal
 {
-  std::optional<ParsedHeaders> HpackDecoder::decode(const std::vector<std::uint8_t>& block) const
+  bool HpackDecoder::decode(std::span<const std::uint8_t> block, HeaderView& out) const
   {
+    out.clear();
     if (inflater_ == nullptr)
     {
-      return std::nullopt;
+      return false;
     }
 
-    ParsedHeaders out;
     std::size_t off = 0;
 
     while (off < block.size())
@@ -28,16 +25,16 @@ namespace neonsignal
                                           block.size() - off, 1);
       if (rv < 0)
       {
-        return std::nullopt;
+        return false;
       }
       off += static_cast<std::size_t>(rv);
 
       if (inflate_flags & NGHTTP2_HD_INFLATE_EMIT)
       {
-        std::string name(reinterpret_cast<char const*>(nv.name), nv.namelen);
-        std::string value(reinterpret_cast<char const*>(nv.value), nv.valuelen);
-        std::ranges::transform(name, name.begin(),
-                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        // nv points into the inflater's table and is only valid until the
+        // next inflate call, so copy into the view's arena.
+        std::string_view name = out.store(nv.name, nv.namelen, true);
+        std::string_view value = out.store(nv.value, nv.valuelen);
 
         if (name == ":path")
         {
@@ -57,17 +54,9 @@ namespace neonsignal
         }
         else
         {
-          if (name == "cookie")
-          {
-            auto it = out.headers.find("cookie");
-            if (it != out.headers.end())
-            {
-              it->second.append("; ");
-              it->second.append(value);
-              continue;
-            }
-          }
-          out.headers[name] = value;
+          // Split cookie fields are kept as-is; HeaderView::cookie() scans
+          // all of them.
+          out.add(name, value);
         }
       }
 
@@ -79,10 +68,6 @@ namespace neonsignal
 
     nghttp2_hd_inflate_end_headers(inflater_);
 
-    if (out.path.empty())
-    {
-      return std::nullopt;
-    }
-    return out;
+    return !out.path.empty();
   }
 } // namespace neonsignal
@@ -0,0 +1,17 @@
+#include "spin/hpack_encoder.h++"
+
+namespace neonsignal {
+
+HpackEncoder::HpackEncoder() {
+  if (nghttp2_hd_deflate_new(&deflater_, kTableSize) != 0) {
+    deflater_ = nullptr;
+  }
+}
+
+HpackEncoder::~HpackEncoder() {
+  if (deflater_ != nullptr) {
+    nghttp2_hd_deflate_del(deflater_);
+  }
+}
+
+} // namespace neonsignal
@@ -0,0 +1,70 @@
+#include "spin/hpack_encoder.h++"
+#include "spin/http2_listener_helpers.h++"
+
+#include <charconv>
+#include <string>
+#include <vector>
+
+namespace neonsignal {
+
+namespace {
+
+nghttp2_nv make_nv(std::string_view name, std::string_view value, std::uint8_t flags) {
+  // nghttp2 never writes through these pointers.
+  return {reinterpret_cast<std::uint8_t*>(const_cast<char*>(name.data())),
+          reinterpret_cast<std::uint8_t*>(const_cast<char*>(value.data())), name.size(),
+          value.size(), static_cast<std::uint8_t>(flags | NGHTTP2_NV_FLAG_NO_COPY_NAME |
+                                                  NGHTTP2_NV_FLAG_NO_COPY_VALUE)};
+}
+
+} // namespace
+
+void HpackEncoder::encode(std::vector<std::uint8_t>& out, int status,
+                          std::string_view content_type,
+                          const std::vector<std::pair<std::string, std::string>>& extra_headers) {
+  if (deflater_ == nullptr) {
+    encode_response_headers(out, status, content_type, extra_headers);
+    return;
+  }
+
+  char status_buf[8];
+  auto [status_end, ec] = std::to_chars(status_buf, status_buf + sizeof(status_buf), status);
+  if (ec != std::errc{}) {
+    status_end = status_buf;
+  }
+
+  nva_.clear();
+  nva_.push_back(make_nv(":status", {status_buf, static_cast<std::size_t>(status_end - status_buf)},
+                         NGHTTP2_NV_FLAG_NONE));
+  if (!content_type.empty()) {
+    nva_.push_back(make_nv("content-type", content_type, NGHTTP2_NV_FLAG_NONE));
+  }
+  for (const auto& [name, value] : extra_headers) {
+    // Session tokens must never enter either side's dynamic table.
+    auto flags = name == "set-cookie" ? NGHTTP2_NV_FLAG_NO_INDEX : NGHTTP2_NV_FLAG_NONE;
+    nva_.push_back(make_nv(name, value, flags));
+  }
+
+  const auto base = out.size();
+  const auto bound = nghttp2_hd_deflate_bound(deflater_, nva_.data(), nva_.size());
+  out.resize(base + bound);
+  auto rv = nghttp2_hd_deflate_hd(deflater_, out.data() + base, bound, nva_.data(), nva_.size());
+  if (rv < 0) {
+    // The deflater is unusable after an error; literals without indexing
+    // leave the peer's table untouched, so they stay valid from here on.
+    out.resize(base);
+    nghttp2_hd_deflate_del(deflater_);
+    deflater_ = nullptr;
+    encode_response_headers(out, status, content_type, extra_headers);
+    return;
+  }
+  out.resize(base + static_cast<std::size_t>(rv));
+}
+
+void HpackEncoder::set_max_table_size(std::uint32_t size) {
+  if (deflater_ != nullptr) {
+    nghttp2_hd_deflate_change_table_size(deflater_, size);
+  }
+}
+
+} // namespace neonsignal
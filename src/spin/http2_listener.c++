@@ -6,6 +6,7 @@
 #include "spin/mail_cookie_store.h++"
 #include "spin/mail_service.h++"
 
+#include <algorithm>
 #include <csignal>
 #include <stdexcept>
 #include <unistd.h>
@@ -13,31 +14,42 @@
 namespace neonsignal {
 
 Http2Listener::Http2Listener(EventLoop& loop, ThreadPool& pool, SSL_CTX* ssl_ctx,
-                             ServerConfig config, const Router& router,
+                             ServerConfig config, const Router& router, SharedState& shared,
                              std::atomic<std::uint64_t>& served_files,
                              std::atomic<std::uint64_t>& page_views,
-                             std::atomic<std::uint64_t>& event_clients)
+                             std::atomic<std::uint64_t>& event_clients,
+                             std::size_t reactor_id, std::size_t reactor_count)
     : loop_(loop), pool_(pool), ssl_ctx_(ssl_ctx), config_(std::move(config)),
       router_(router), served_files_(served_files), page_views_(page_views),
-      event_clients_(event_clients),
-      conn_manager_(std::make_unique<ConnectionManager>()),
-      static_cache_(std::make_unique<StaticFileCache>()),
-      session_cache_(std::make_unique<SessionCache>()),
-      sse_broadcaster_(std::make_unique<SSEBroadcaster>()),
-      db_(std::make_unique<Database>(config_.db_path)),
-      mail_service_(std::make_unique<MailService>(*db_, config_.mail)),
-      mail_cookie_store_(std::make_unique<MailCookieStore>(config_.mail)),
-      auth_(config_.rp_id, config_.origin, *db_),
-      api_handler_(std::make_unique<ApiHandler>(loop_, auth_, router_, *db_,
-                                                served_files_, page_views_, event_clients_,
+      event_clients_(event_clients), reactor_id_(reactor_id),
+      conn_manager_(std::make_unique<ConnectionManager>(
+          std::max<std::size_t>(1, ConnectionManager::MAX_CONNECTIONS /
+                                       std::max<std::size_t>(1, reactor_count)))),
+      sse_broadcaster_(std::make_unique<SSEBroadcaster>(
+          loop_, SSEResetPolicy{}, ConnectionManager::MAX_WRITE_BUFFER_BYTES, event_clients_)),
+      shared_(shared),
+      static_caches_(*shared.static_caches),
+      static_cache_(shared.static_caches->for_root(shared.config.www_root)),
+      session_cache_(*shared.session_cache),
+      db_(*shared.db),
+      mail_service_(*shared.mail_service),
+      mail_cookie_store_(*shared.mail_cookie_store),
+      redirect_service_ok_(shared.redirect_service_ok),
+      auth_(shared.auth),
+      vhost_resolver_(shared.vhost_resolver),
+      metrics_(shared.metrics),
+      connections_gauge_(shared.metrics.connections(reactor_id)),
+      write_buffer_gauge_(shared.metrics.write_buffer_bytes(reactor_id)),
+      default_vhost_requests_(shared.metrics.vhost_requests("default")),
+      api_handler_(std::make_unique<ApiHandler>(loop_, pool_, auth_, router_, db_,
+                                                served_files_, page_views_, *sse_broadcaster_,
                                                 redirect_service_ok_,
-                                                *mail_service_, *mail_cookie_store_,
-                                                config_.mail)),
-      vhost_resolver_(config_.www_root) {
+                                                mail_service_, mail_cookie_store_,
+                                                shared_.config.mail,
+                                                shared_.metrics_registry)) {
   if (!ssl_ctx_) {
     throw std::runtime_error("Http2Listener requires a valid SSL_CTX");
   }
-  auth_.load_credentials();
   signal(SIGPIPE, SIG_IGN);
 }
 
@@ -21,13 +21,9 @@ void Http2Listener::close_connection_(int fd) {
   conn->closed = true;
   loop_.remove_fd(fd);
 
-  // Unsubscribe from all SSE channels
+  // Unsubscribe from all SSE channels (also maintains the event client count)
   sse_broadcaster_->unsubscribe_all(fd);
 
-  if (conn->is_event_stream) {
-    --event_clients_;
-  }
-  // No special count change for CPU streams; just close cleanly.
   SSL_shutdown(conn->ssl.get());
   close(fd);
 
@@ -0,0 +1,25 @@
+#include "spin/http2_listener.h++"
+
+namespace neonsignal {
+
+void Http2Listener::count_request_(const std::string& authority) {
+  // Clients choose the authority, so only the first few distinct values get a
+  // cache slot; the label itself is the vhost directory, which is bounded.
+  constexpr std::size_t kMaxCachedAuthorities = 1024;
+
+  auto it = vhost_requests_.find(authority);
+  if (it != vhost_requests_.end()) {
+    it->second->add();
+    return;
+  }
+  Counter* counter = &default_vhost_requests_;
+  if (auto root = vhost_resolver_.resolve(authority)) {
+    counter = &metrics_.vhost_requests(root->filename().string());
+  }
+  if (vhost_requests_.size() < kMaxCachedAuthorities) {
+    vhost_requests_.emplace(authority, counter);
+  }
+  counter->add();
+}
+
+} // namespace neonsignal
@@ -1,6 +1,7 @@
 #include "spin/http2_listener.h++"
 #include "spin/event_mask.h++"
 
+#include "neonsignal/logging.h++"
 #include "spin/http2_listener_helpers.h++"
 
 #include <fcntl.h>
@@ -36,9 +37,12 @@ void Http2Listener::handle_connection_(int client_fd) {
       std::chrono::steady_clock::now() + std::chrono::seconds(5);
   conn->events = EventMask::Read | EventMask::Write;
   conn->decoder = std::make_unique<HpackDecoder>();
+  conn->metrics = &metrics_;
 
-  std::cerr << "• Accepted HTTP/2-capable TLS connection fd=" << client_fd
-            << '\n';
+  if (log_enabled(LogLevel::debug)) {
+    std::cerr << "• Accepted HTTP/2-capable TLS connection fd=" << client_fd
+              << '\n';
+  }
   register_connection_(std::move(conn));
 }
 
@@ -1,3 +1,4 @@
+#include "neonsignal/logging.h++"
 #include "spin/api_handler.h++"
 #include "spin/event_loop.h++"
 #include "spin/event_mask.h++"
@@ -7,6 +8,7 @@
 #include "spin/routes.h++"
 #include "spin/mail_config.h++"
 #include "spin/mail_cookie_store.h++"
+#include "spin/metrics.h++"
 
 #if defined(__GLIBC__)
 #include <malloc.h>
@@ -19,7 +21,6 @@
 #include <chrono>
 #include <cctype>
 #include <cstring>
-#include <ctime>
 #include <filesystem>
 #include <format>
 #include <fstream>
@@ -29,7 +30,6 @@
 #include <sys/socket.h>
 #include <string>
 #include <string_view>
-#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -37,26 +37,6 @@ namespace neonsignal {
 
 namespace {
 
-std::optional<std::string>
-extract_cookie(const std::unordered_map<std::string, std::string> &headers, std::string_view name) {
-  auto it = headers.find("cookie");
-  if (it == headers.end()) {
-    return std::nullopt;
-  }
-  std::string_view cookie = it->second;
-  std::string needle = std::string(name) + "=";
-  std::size_t pos = cookie.find(needle);
-  if (pos == std::string::npos) {
-    return std::nullopt;
-  }
-  pos += needle.size();
-  std::size_t end = cookie.find(';', pos);
-  if (end == std::string::npos) {
-    end = cookie.size();
-  }
-  return std::string(cookie.substr(pos, end - pos));
-}
-
 std::string normalize_authority(std::string_view authority) {
   if (const auto pos = authority.find(':'); pos != std::string_view::npos) {
     authority = authority.substr(0, pos);
@@ -138,6 +118,18 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
     int ret = SSL_accept(conn->ssl.get());
     if (ret == 1) {
       conn->handshake_complete = true;
+      metrics_.tls_handshake.record(now - conn->created_at);
+      if (SSL_session_reused(conn->ssl.get()) == 1) {
+        metrics_.tls_resumed_handshakes.add();
+      } else {
+        metrics_.tls_full_handshakes.add();
+      }
+      // OpenSSL switches to kernel TLS on its own when the context asked for
+      // it and the kernel took the keys; file bodies can then skip user space.
+      if (BIO_get_ktls_send(SSL_get_wbio(conn->ssl.get()))) {
+        conn->flow.enable_sendfile();
+        metrics_.ktls_connections.add();
+      }
       conn->events = EventMask::Read | EventMask::Write;
       if (!conn->server_settings_sent) {
         auto settings = build_server_settings();
@@ -168,10 +160,12 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
   if (events & EventMask::Read) {
     bool ok = true;
     for (;;) {
-      std::uint8_t buf[4096];
-      int n = SSL_read(conn->ssl.get(), buf, sizeof(buf));
+      // Decrypt straight into the connection buffer (one TLS record at a time).
+      constexpr std::size_t kReadChunk = 16 * 1024;
+      int n = SSL_read(conn->ssl.get(), conn->read_buf.prepare(kReadChunk),
+                       static_cast<int>(kReadChunk));
       if (n > 0) {
-        conn->read_buf.insert(conn->read_buf.end(), buf, buf + n);
+        conn->read_buf.commit(static_cast<std::size_t>(n));
       } else {
         int err = SSL_get_error(conn->ssl.get(), n);
         if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) {
@@ -192,7 +186,7 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
       if (conn->read_buf.size() < kClientPreface.size()) {
         // Wait for full preface.
       } else {
-        std::string_view got(reinterpret_cast<char *>(conn->read_buf.data()),
+        std::string_view got(reinterpret_cast<const char *>(conn->read_buf.data()),
                              kClientPreface.size());
         if (got != kClientPreface) {
           std::cerr << "✗ Invalid HTTP/2 preface on fd=" << conn->fd << '\n';
@@ -200,9 +194,10 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
           return;
         }
         conn->preface_ok = true;
-        conn->read_buf.erase(conn->read_buf.begin(),
-                             conn->read_buf.begin() + kClientPreface.size());
-        std::cerr << "• Preface received fd=" << conn->fd << '\n';
+        conn->read_buf.consume(kClientPreface.size());
+        if (log_enabled(LogLevel::debug)) {
+          std::cerr << "• Preface received fd=" << conn->fd << '\n';
+        }
       }
     }
 
@@ -218,24 +213,65 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
         break;
       }
 
-      std::vector<std::uint8_t> payload(conn->read_buf.begin() + 9,
-                                        conn->read_buf.begin() + 9 + static_cast<std::size_t>(len));
+      std::vector<std::uint8_t> payload(conn->read_buf.data() + 9,
+                                        conn->read_buf.data() + 9 + static_cast<std::size_t>(len));
 
-      conn->read_buf.erase(conn->read_buf.begin(),
-                           conn->read_buf.begin() + 9 + static_cast<std::size_t>(len));
+      conn->read_buf.consume(9 + static_cast<std::size_t>(len));
 
       if (type == 0x4 /* SETTINGS */) {
         if ((flags & 0x1) == 0) {
+          // Apply the peer's window and frame size before acknowledging.
+          if (stream_id != 0 || !conn->flow.on_settings(payload)) {
+            std::cerr << "✗ Invalid SETTINGS fd=" << conn->fd << '\n';
+            close_connection_(conn->fd);
+            return;
+          }
+          // SETTINGS_HEADER_TABLE_SIZE bounds our encoder's dynamic table.
+          for (std::size_t i = 0; i + 6 <= payload.size(); i += 6) {
+            if (((payload[i] << 8) | payload[i + 1]) == 0x1) {
+              conn->encoder.set_max_table_size(
+                  (static_cast<std::uint32_t>(payload[i + 2]) << 24) |
+                  (static_cast<std::uint32_t>(payload[i + 3]) << 16) |
+                  (static_cast<std::uint32_t>(payload[i + 4]) << 8) | payload[i + 5]);
+            }
+          }
           conn->client_settings_seen = true;
           auto ack = build_settings_ack();
           conn->write_buf.insert(conn->write_buf.end(), ack.begin(), ack.end());
           conn->events |= EventMask::Write;
           loop_.update_fd(conn->fd, conn->events);
-          std::cerr << "• Client SETTINGS received fd=" << conn->fd << '\n';
+          if (log_enabled(LogLevel::debug)) {
+            std::cerr << "• Client SETTINGS received fd=" << conn->fd << '\n';
+          }
+        }
+        continue;
+      }
+
+      if (type == 0x8 /* WINDOW_UPDATE */) {
+        if (payload.size() != 4) {
+          close_connection_(conn->fd);
+          return;
+        }
+        std::uint32_t increment = ((payload[0] & 0x7Fu) << 24) | (payload[1] << 16) |
+                                  (payload[2] << 8) | payload[3];
+        if (!conn->flow.on_window_update(stream_id, increment)) {
+          std::cerr << "✗ Flow control error fd=" << conn->fd << " stream=" << stream_id << '\n';
+          close_connection_(conn->fd);
+          return;
+        }
+        if (conn->flow.has_sendable()) {
+          conn->events |= EventMask::Write;
+          loop_.update_fd(conn->fd, conn->events);
         }
         continue;
       }
 
+      if (type == 0x3 /* RST_STREAM */) {
+        conn->flow.close_stream(stream_id);
+        sse_broadcaster_->unsubscribe_stream(conn->fd, stream_id);
+        continue;
+      }
+
       if (type == 0x1 /* HEADERS */ || type == 0x9 /* CONTINUATION */) {
         // Handle padding and priority on initial HEADERS only.
         std::size_t start = 0;
@@ -273,37 +309,39 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
           if (!conn->decoder) {
             conn->decoder = std::make_unique<HpackDecoder>();
           }
-          auto parsed = conn->decoder->decode(block);
+          auto &header_map = conn->request_headers;
+          bool parsed = conn->decoder->decode(block, header_map);
           block.clear();
           std::string path = "/";
           std::string method = "GET";
           std::string authority = "";
-          std::unordered_map<std::string, std::string> header_map;
           std::string upload_header_name;
           if (parsed) {
-            if (!parsed->path.empty()) {
-              path = parsed->path;
-            }
-            if (!parsed->method.empty()) {
-              method = parsed->method;
-            }
-            if (!parsed->authority.empty()) {
-              authority = parsed->authority;
+            path = header_map.path;
+            if (!header_map.method.empty()) {
+              method = header_map.method;
             }
-            header_map = parsed->headers;
-            auto it_name = parsed->headers.find("x-filename");
-            if (it_name != parsed->headers.end()) {
-              upload_header_name = it_name->second;
+            authority = header_map.authority;
+            if (auto name = header_map.get("x-filename")) {
+              upload_header_name = *name;
             }
           } else {
+            header_map.clear();
             std::cerr << "▲ Missing or invalid headers, defaulting path=/ fd=" << conn->fd
                       << " stream=" << stream_id << '\n';
           }
 
-          std::cerr << "• HEADERS on fd=" << conn->fd << " stream=" << stream_id << " path=" << path
-                    << " method=" << method << " authority=" << authority << '\n';
+          if (log_enabled(LogLevel::debug)) {
+            std::cerr << "• HEADERS on fd=" << conn->fd << " stream=" << stream_id
+                      << " path=" << path << " method=" << method << " authority=" << authority
+                      << '\n';
+          }
 
           conn->last_path = path;
+          if (conn->awaiting_first_byte == std::chrono::steady_clock::time_point{}) {
+            conn->awaiting_first_byte = now;
+          }
+          count_request_(authority);
 
           // SWITCH APIs and SPECIAL PATHS
           auto api_route = identify_api_route(path);
@@ -311,7 +349,10 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
           // PROTECTED PATHS
           if (auth_.is_protected_path(path)) {
             std::string user;
-            auto cookie = extract_cookie(header_map, "ns_session");
+            std::optional<std::string> cookie;
+            if (auto value = header_map.cookie("ns_session")) {
+              cookie.emplace(*value);
+            }
             auto build_auth_fail_headers = []() {
               return std::vector<std::pair<std::string, std::string>>{
                   {"set-cookie", "ns_session=; Path=/; Max-Age=0; HttpOnly; Secure; SameSite=Lax"},
@@ -323,13 +364,13 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
               std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
               if (api_route != ApiRoute::None) {
                 auto hdrs = build_auth_fail_headers();
-                build_response_frames_with_headers(conn->write_buf, stream_id, 500,
+                build_response_frames_with_headers(*conn, stream_id, 500,
                                                    "application/json", hdrs, body_bytes);
               } else {
                 std::string loc = std::string(routes::auth_redirect());
                 auto hdrs = build_auth_fail_headers();
                 hdrs.emplace_back("location", loc);
-                build_response_frames_with_headers(conn->write_buf, stream_id, 302,
+                build_response_frames_with_headers(*conn, stream_id, 302,
                                                    "application/json", hdrs, body_bytes);
               }
               conn->events |= EventMask::Write;
@@ -339,23 +380,30 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
 
             // Check SessionCache first (60s TTL caching)
             bool valid = false;
-            auto cached = session_cache_->get(*cookie);
+            auto cached = session_cache_.get(*cookie);
             if (cached) {
               user = cached->user_id;
               valid = true;
-              std::cerr << "• auth: session cache HIT user=" << user << " path=" << path << '\n';
+              metrics_.session_cache_hits.add();
+              if (log_enabled(LogLevel::debug)) {
+                std::cerr << "• auth: session cache HIT user=" << user << " path=" << path
+                          << '\n';
+              }
             } else {
+              metrics_.session_cache_misses.add();
               // Cache miss - validate with auth and cache result
               valid = auth_.validate_session(*cookie, user);
               if (valid) {
                 auto now = std::chrono::steady_clock::now();
-                session_cache_->put(*cookie, {.user_id = user,
+                session_cache_.put(*cookie, {.user_id = user,
                                               .credential_id = "",
                                               .cached_at = now,
                                               .expires_at = now + std::chrono::seconds(60),
                                               .authenticated = true});
-                std::cerr << "• auth: session cache MISS, validated user=" << user << " path=" << path
-                          << '\n';
+                if (log_enabled(LogLevel::debug)) {
+                  std::cerr << "• auth: session cache MISS, validated user=" << user
+                            << " path=" << path << '\n';
+                }
               }
             }
 
@@ -366,13 +414,13 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
               std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
               if (api_route != ApiRoute::None) {
                 auto hdrs = build_auth_fail_headers();
-                build_response_frames_with_headers(conn->write_buf, stream_id, 500,
+                build_response_frames_with_headers(*conn, stream_id, 500,
                                                    "application/json", hdrs, body_bytes);
               } else {
                 std::string loc = std::string(routes::auth_redirect());
                 auto hdrs = build_auth_fail_headers();
                 hdrs.emplace_back("location", loc);
-                build_response_frames_with_headers(conn->write_buf, stream_id, 302,
+                build_response_frames_with_headers(*conn, stream_id, 302,
                                                    "application/json", hdrs, body_bytes);
               }
               conn->events |= EventMask::Write;
@@ -410,7 +458,7 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
                                                             method);
             break;
           case ApiRoute::CodexList:
-            handled_api = api_handler_->codex_list(conn, stream_id);
+            handled_api = api_handler_->codex_list(conn, stream_id, path);
             break;
           case ApiRoute::CodexItem:
             handled_api = api_handler_->codex_item(conn, stream_id, path);
@@ -457,35 +505,16 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
             handled_api =
                 api_handler_->redirect_service_stream(conn, stream_id, path, method, authority);
             break;
+          case ApiRoute::Metrics:
+            handled_api = api_handler_->metrics(conn, stream_id, path, method, authority);
+            break;
+          case ApiRoute::MetricsStream:
+            handled_api = api_handler_->metrics_stream(conn, stream_id, path, method, authority);
+            break;
           default:
             break;
           }
           if (handled_api) {
-            // Subscribe to SSE channels if stream was set up, and initialize counters.
-            if (conn->is_event_stream) {
-              conn->event_sse_count = 0;
-              conn->event_sse_start = std::chrono::steady_clock::now();
-              sse_broadcaster_->subscribe(SSEBroadcaster::Channel::Events, conn->fd, conn,
-                                          conn->event_stream_id);
-            }
-            if (conn->is_cpu_stream) {
-              conn->cpu_sse_count = 0;
-              conn->cpu_sse_start = std::chrono::steady_clock::now();
-              sse_broadcaster_->subscribe(SSEBroadcaster::Channel::CPUMetrics, conn->fd, conn,
-                                          conn->cpu_stream_id);
-            }
-            if (conn->is_mem_stream) {
-              conn->mem_sse_count = 0;
-              conn->mem_sse_start = std::chrono::steady_clock::now();
-              sse_broadcaster_->subscribe(SSEBroadcaster::Channel::MemMetrics, conn->fd, conn,
-                                          conn->mem_stream_id);
-            }
-            if (conn->is_redirect_stream) {
-              conn->redirect_sse_count = 0;
-              conn->redirect_sse_start = std::chrono::steady_clock::now();
-              sse_broadcaster_->subscribe(SSEBroadcaster::Channel::Redirect, conn->fd, conn,
-                                          conn->redirect_stream_id);
-            }
             continue;
           }
 
@@ -494,20 +523,31 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
           // Virtual host resolution - check if authority maps to a vhost directory
           StaticResult res;
           auto vhost_root = vhost_resolver_.resolve(authority);
+          StaticFileCache* vhost_cache =
+              vhost_root ? &static_caches_.for_root(*vhost_root) : nullptr;
+          EncodingMask accepted = kIdentityOnly;
+          if (auto value = header_map.get("accept-encoding")) {
+            accepted = parse_accept_encoding(*value);
+          }
           if (vhost_root) {
-            // Use vhost-specific document root
-            res = load_static_vhost(path, *vhost_root, router_);
+            // Use vhost-specific document root and its own cache
+            res = load_static_vhost(path, *vhost_root, router_, vhost_cache, accepted);
           } else {
             // Fallback to default public root with cache
-            res = load_static(path, router_, static_cache_.get());
+            res = load_static(path, router_, &static_cache_, accepted);
+          }
+          if (res.status == 200) {
+            (res.cache_hit ? metrics_.static_cache_hits : metrics_.static_cache_misses).add();
           }
 
-          // SPA routes - serve index.html shell with correct path for client-side routing
+          // SPA routes - serve index.html shell with correct path for client-side routing.
+          // The shell body is rewritten below, so it is always loaded uncompressed.
           auto load_shell = [&]() -> StaticResult {
             if (vhost_root) {
-              return load_static_vhost(std::string(routes::pages::kIndex), *vhost_root, router_);
+              return load_static_vhost(std::string(routes::pages::kIndex), *vhost_root, router_,
+                                       vhost_cache);
             }
-            return load_static(std::string(routes::pages::kIndex), router_, static_cache_.get());
+            return load_static(std::string(routes::pages::kIndex), router_, &static_cache_);
           };
 
           if (res.status == 404 && is_html && vhost_resolver_.is_neonjsx(authority)) {
@@ -516,7 +556,8 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
               res.content_type = shell.content_type;
               const bool is_known_route = vhost_resolver_.is_neonjsx_route(authority, path);
               res.status = is_known_route ? 200 : 404;
-              std::string body_str(shell.body.begin(), shell.body.end());
+              auto shell_body = shell.copy_body();
+              std::string body_str(shell_body.begin(), shell_body.end());
               body_str += "<script>";
               if (!is_known_route) {
                 body_str += "window.__NEON_STATUS=404;";
@@ -550,10 +591,10 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
                 break;
               }
             }
-            if (should_set_mail_cookie && mail_cookie_store_) {
+            if (should_set_mail_cookie) {
               auto client_ip = get_client_ip(conn->fd);
               if (!client_ip.empty()) {
-                auto cookie_code = mail_cookie_store_->generate_and_store(client_ip);
+                auto cookie_code = mail_cookie_store_.generate_and_store(client_ip);
                 if (!cookie_code.empty()) {
                   std::string cookie_header = std::format(
                       "{}={}; Path=/; Max-Age={}; Secure; SameSite=Lax",
@@ -567,10 +608,27 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
           }
 
           // as you can see anytime the path:/upload goes it returns a 404 cause file is not there
-          if (extra_headers.empty()) {
-            build_response_frames(conn->write_buf, stream_id, res.status, res.content_type, res.body);
+          auto if_none_match = header_map.get("if-none-match");
+          if (if_none_match && extra_headers.empty() && res.has_etag_match(*if_none_match)) {
+            res.cached->append_not_modified(conn->write_buf, stream_id);
+            metrics_.count_status(304);
+          } else if (res.cached) {
+            res.cached->append_headers(conn->write_buf, stream_id, extra_headers);
+            res.cached->queue_body(conn->flow, stream_id);
+            metrics_.count_status(200);
+          } else if (!res.stream_file.empty()) {
+            if (conn->flow.attach_file(stream_id, res.stream_file, res.stream_size)) {
+              extra_headers.emplace_back("content-length", std::to_string(res.stream_size));
+              append_headers_frame(*conn, stream_id, 200, res.content_type, extra_headers);
+            } else {
+              std::vector<std::uint8_t> error_body{'E', 'r', 'r', 'o', 'r'};
+              build_response_frames(*conn, stream_id, 500, "text/plain; charset=utf-8",
+                                    error_body);
+            }
+          } else if (extra_headers.empty()) {
+            build_response_frames(*conn, stream_id, res.status, res.content_type, res.body);
           } else {
-            build_response_frames_with_headers(conn->write_buf, stream_id, res.status,
+            build_response_frames_with_headers(*conn, stream_id, res.status,
                                                res.content_type, extra_headers, res.body);
           }
           if (res.status == 200 && is_html) {
@@ -578,32 +636,15 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
           }
           ++served_files_;
 
-          // Broadcast stats update to all Events channel subscribers
-          auto files = served_files_.load();
-          auto pages = page_views_.load();
-          std::string event_body = "data: {\"files_served\": " + std::to_string(files) +
-                                   ",\"page_views\": " + std::to_string(pages) + "}\n\n";
-          std::vector<std::uint8_t> event_bytes(event_body.begin(), event_body.end());
-
-          sse_broadcaster_->for_each_subscriber(
-              SSEBroadcaster::Channel::Events,
-              [&](const std::shared_ptr<Http2Connection> &c, std::uint32_t stream_id) {
-                // Skip connections with write backpressure
-                if (conn_manager_->has_write_backpressure(c)) {
-                  return;
-                }
-                auto data_frame = build_frame(0x0 /* DATA */, 0x0, stream_id, event_bytes);
-                c->write_buf.insert(c->write_buf.end(), data_frame.begin(), data_frame.end());
-                c->events |= EventMask::Write;
-                loop_.update_fd(c->fd, c->events);
-              });
           conn->events |= EventMask::Write;
           loop_.update_fd(conn->fd, conn->events);
-          if (path == routes::pages::kHome || path == routes::pages::kIndex) {
-            std::cerr << "• Serving index.html\n";
+          if (log_enabled(LogLevel::debug)) {
+            if (path == routes::pages::kHome || path == routes::pages::kIndex) {
+              std::cerr << "• Serving index.html\n";
+            }
+            std::cerr << "• HEADERS on fd=" << conn->fd << " path=" << path
+                      << " method=" << method << " authority=" << authority << '\n';
           }
-          std::cerr << "• HEADERS on fd=" << conn->fd << " path=" << path << " method=" << method
-                    << " authority=" << authority << '\n';
         }
         continue;
       }
@@ -626,7 +667,7 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
           if (st.received_bytes > kMaxUploadBytes) {
             std::string body = "Payload too large";
             std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-            build_response_frames(conn->write_buf, stream_id, 413, "text/plain; charset=utf-8",
+            build_response_frames(*conn, stream_id, 413, "text/plain; charset=utf-8",
                                   body_bytes);
             if (st.file.is_open()) {
               st.file.close();
@@ -652,7 +693,7 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
           if (st.body.size() + payload.size() > kMaxUploadBytes) {
             std::string body = "Payload too large";
             std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-            build_response_frames(conn->write_buf, stream_id, 413, "text/plain; charset=utf-8",
+            build_response_frames(*conn, stream_id, 413, "text/plain; charset=utf-8",
                                   body_bytes);
             conn->events |= EventMask::Write;
             loop_.update_fd(conn->fd, conn->events);
@@ -690,7 +731,7 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
                 status = 401;
                 std::string err = "{\"error\":\"" + auth_res.error + "\"}";
                 body_bytes.assign(err.begin(), err.end());
-                build_response_frames(conn->write_buf, stream_id, status, content_type, body_bytes);
+                build_response_frames(*conn, stream_id, status, content_type, body_bytes);
                 conn->events |= EventMask::Write;
                 loop_.update_fd(conn->fd, conn->events);
                 st.responded = true;
@@ -710,7 +751,7 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
               std::cerr << "✓ auth: issued session for user=" << auth_res.user
                         << " session=" << auth_res.session_id << '\n';
               build_response_frames_with_headers(
-                  conn->write_buf, stream_id, 200, content_type,
+                  *conn, stream_id, 200, content_type,
                   {{"set-cookie", cookie}, {"set-cookie", dbg_cookie}}, body_bytes);
               conn->events |= EventMask::Write;
               loop_.update_fd(conn->fd, conn->events);
@@ -752,7 +793,7 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
                     std::string dbg_cookie = "ns_debug=" + session_id +
                                              "; Path=/; Max-Age=300; Secure; SameSite=Lax";
                     build_response_frames_with_headers(
-                        conn->write_buf, stream_id, status, content_type,
+                        *conn, stream_id, status, content_type,
                         {{"set-cookie", cookie}, {"set-cookie", dbg_cookie}}, body_bytes);
                     conn->events |= EventMask::Write;
                     loop_.update_fd(conn->fd, conn->events);
@@ -781,7 +822,7 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
                     std::string dbg_cookie = "ns_debug=" + session_id +
                                              "; Path=/; Max-Age=432000; Secure; SameSite=Lax";
                     build_response_frames_with_headers(
-                        conn->write_buf, stream_id, status, content_type,
+                        *conn, stream_id, status, content_type,
                         {{"set-cookie", cookie}, {"set-cookie", dbg_cookie}}, body_bytes);
                     conn->events |= EventMask::Write;
                     loop_.update_fd(conn->fd, conn->events);
@@ -810,7 +851,7 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
             }
           }
 
-          build_response_frames(conn->write_buf, stream_id, status, content_type, body_bytes);
+          build_response_frames(*conn, stream_id, status, content_type, body_bytes);
           ++served_files_;
           conn->events |= EventMask::Write;
           loop_.update_fd(conn->fd, conn->events);
@@ -842,7 +883,8 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
 
   if (events & EventMask::Write) {
     auto now = std::chrono::steady_clock::now();
-    static std::chrono::steady_clock::time_point last_trim{};
+    // thread_local: each reactor thread trims on its own schedule without racing.
+    thread_local std::chrono::steady_clock::time_point last_trim{};
     if (last_trim.time_since_epoch().count() == 0 || (now - last_trim) >= std::chrono::minutes(5)) {
       // Best-effort memory trim to return free pages to OS.
       last_trim = now;
@@ -850,161 +892,40 @@ void Http2Listener::handle_io_(const std::shared_ptr<Http2Connection> &conn, std
       (void)malloc_trim(0);
 #endif
     }
-    auto should_reset = [&](bool is_stream, std::uint64_t count,
-                            std::chrono::steady_clock::time_point start) {
-      if (!is_stream) {
-        return false;
-      }
-      if (start.time_since_epoch().count() == 0) {
-        return false;
-      }
-      bool time_exceeded = (sse_policy_.mode == SSEResetPolicy::Mode::OnlyCount)
-                               ? false
-                               : (now - start >= sse_policy_.max_age);
-      bool count_exceeded = (sse_policy_.mode == SSEResetPolicy::Mode::OnlyTime)
-                                ? false
-                                : (count >= sse_policy_.max_messages);
-      if (sse_policy_.mode == SSEResetPolicy::Mode::Both) {
-        return time_exceeded || count_exceeded;
+    // Bytes queued ahead of the socket; DATA beyond this waits in the
+    // scheduler (or on disk) until the queue drains.
+    constexpr std::size_t kSendBudget = 128 * 1024;
+    conn->flow.stage(conn->write_buf, conn->send_queue);
+    conn->flow.pump(conn->send_queue, kSendBudget);
+    bool wrote = false;
+    for (;;) {
+      int err = 0;
+      const auto queued = conn->send_queue.bytes();
+      auto result = conn->send_queue.flush(conn->ssl.get(), err);
+      if (result == WriteQueue::FlushResult::Error) {
+        std::cerr << "✗ SSL_write failed fd=" << conn->fd << " err=" << err << '\n';
+        close_connection_(conn->fd);
+        return;
       }
-      return time_exceeded || count_exceeded;
-    };
-
-    auto reset_stream = [&](bool &flag, std::uint32_t stream_id, std::uint64_t &count,
-                            std::chrono::steady_clock::time_point &start) {
-      auto data_frame = build_frame(0x0 /* DATA */, 0x1 /* END_STREAM */, stream_id, {});
-      conn->write_buf.insert(conn->write_buf.end(), data_frame.begin(), data_frame.end());
-      flag = false;
-      count = 0;
-      start = {};
-      conn->events |= EventMask::Write;
-    };
-
-    while (conn->write_offset < conn->write_buf.size()) {
-      int n = SSL_write(conn->ssl.get(), conn->write_buf.data() + conn->write_offset,
-                        static_cast<int>(conn->write_buf.size() - conn->write_offset));
-      if (n > 0) {
-        conn->write_offset += static_cast<std::size_t>(n);
-        continue;
+      wrote = wrote || conn->send_queue.bytes() < queued;
+      if (result == WriteQueue::FlushResult::WouldBlock) {
+        break;
       }
-      int err = SSL_get_error(conn->ssl.get(), n);
-      if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) {
+      conn->flow.pump(conn->send_queue, kSendBudget);
+      if (conn->send_queue.empty()) {
         break;
       }
-      std::cerr << "✗ SSL_write failed fd=" << conn->fd << " err=" << err << '\n';
-      close_connection_(conn->fd);
-      return;
+    }
+    if (wrote && conn->awaiting_first_byte != std::chrono::steady_clock::time_point{}) {
+      metrics_.first_byte.record(std::chrono::steady_clock::now() - conn->awaiting_first_byte);
+      conn->awaiting_first_byte = {};
     }
 
-    if (conn->write_offset >= conn->write_buf.size()) {
-      conn->write_buf.clear();
-      conn->write_offset = 0;
-      conn->events = EventMask::Read;
-      if (conn->is_event_stream) {
-        if (conn->event_sse_start.time_since_epoch().count() == 0) {
-          conn->event_sse_start = now;
-        }
-        if (should_reset(conn->is_event_stream, conn->event_sse_count, conn->event_sse_start)) {
-          reset_stream(conn->is_event_stream, conn->event_stream_id, conn->event_sse_count,
-                       conn->event_sse_start);
-          loop_.update_fd(conn->fd, conn->events);
-          return;
-        }
-        // Throttle events: send every 2 seconds.
-        constexpr auto kEventInterval = std::chrono::seconds(2);
-        if (conn->event_sse_start.time_since_epoch().count() == 0 ||
-            (now - conn->event_sse_start) >= kEventInterval) {
-          conn->event_sse_start = now;
-          std::this_thread::sleep_for(std::chrono::milliseconds(1));
-          std::string body = "data: {\"files_served\": " + std::to_string(served_files_.load()) +
-                             ",\"page_views\": " + std::to_string(page_views_.load()) + "}\n\n";
-          std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-          auto data_frame = build_frame(0x0 /* DATA */, 0x0, conn->event_stream_id, body_bytes);
-          conn->write_buf.insert(conn->write_buf.end(), data_frame.begin(), data_frame.end());
-          conn->events |= EventMask::Write;
-          ++conn->event_sse_count;
-        }
-      }
-      if (conn->is_cpu_stream) {
-        if (conn->cpu_sse_start.time_since_epoch().count() == 0) {
-          conn->cpu_sse_start = now;
-        }
-        if (should_reset(conn->is_cpu_stream, conn->cpu_sse_count, conn->cpu_sse_start)) {
-          reset_stream(conn->is_cpu_stream, conn->cpu_stream_id, conn->cpu_sse_count,
-                       conn->cpu_sse_start);
-          loop_.update_fd(conn->fd, conn->events);
-          return;
-        }
-        // Throttle CPU updates: send every 5 seconds.
-        constexpr auto kCpuInterval = std::chrono::seconds(5);
-        if (conn->cpu_sse_start.time_since_epoch().count() == 0 ||
-            (now - conn->cpu_sse_start) >= kCpuInterval) {
-          conn->cpu_sse_start = now;
-          std::this_thread::sleep_for(std::chrono::milliseconds(1));
-          timespec ts{};
-          clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
-          std::uint64_t cpu_now = static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull +
-                                  static_cast<std::uint64_t>(ts.tv_nsec);
-          auto wall_now = std::chrono::steady_clock::now();
-          double percent = 0.0;
-          if (conn->last_cpu_time_ns != 0 && conn->last_cpu_wall.time_since_epoch().count() != 0) {
-            auto cpu_delta = cpu_now - conn->last_cpu_time_ns;
-            auto wall_delta =
-                std::chrono::duration_cast<std::chrono::nanoseconds>(wall_now - conn->last_cpu_wall)
-                    .count();
-            if (wall_delta > 0) {
-              percent = (static_cast<double>(cpu_delta) / static_cast<double>(wall_delta)) * 100.0;
-            }
-          }
-          conn->last_cpu_time_ns = cpu_now;
-          conn->last_cpu_wall = wall_now;
-
-          std::string body = "data: {\"cpu_percent\": " + std::to_string(percent) + "}\n\n";
-          std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-          auto data_frame = build_frame(0x0 /* DATA */, 0x0, conn->cpu_stream_id, body_bytes);
-          conn->write_buf.insert(conn->write_buf.end(), data_frame.begin(), data_frame.end());
-          conn->events |= EventMask::Write;
-          ++conn->cpu_sse_count;
-        }
-      }
-      if (conn->is_mem_stream) {
-        if (conn->mem_sse_start.time_since_epoch().count() == 0) {
-          conn->mem_sse_start = now;
-        }
-        if (should_reset(conn->is_mem_stream, conn->mem_sse_count, conn->mem_sse_start)) {
-          reset_stream(conn->is_mem_stream, conn->mem_stream_id, conn->mem_sse_count,
-                       conn->mem_sse_start);
-          loop_.update_fd(conn->fd, conn->events);
-          return;
-        }
-        // Throttle memory updates: send every 1 minute.
-        constexpr auto kMemInterval = std::chrono::minutes(1);
-        if (conn->mem_sse_start.time_since_epoch().count() == 0 ||
-            (now - conn->mem_sse_start) >= kMemInterval) {
-          conn->mem_sse_start = now;
-          std::this_thread::sleep_for(std::chrono::milliseconds(1));
-          std::uint64_t rss = read_rss_kb();
-          std::string body = "data: {\"rss_kb\": " + std::to_string(rss) + "}\n\n";
-          std::vector<std::uint8_t> body_bytes(body.begin(), body.end());
-          auto data_frame = build_frame(0x0 /* DATA */, 0x0, conn->mem_stream_id, body_bytes);
-          conn->write_buf.insert(conn->write_buf.end(), data_frame.begin(), data_frame.end());
-          conn->events |= EventMask::Write;
-          conn->last_rss_kb = rss;
-          ++conn->mem_sse_count;
-        }
-      }
-      if (conn->is_redirect_stream) {
-        if (conn->redirect_sse_start.time_since_epoch().count() == 0) {
-          conn->redirect_sse_start = now;
-        }
-        if (should_reset(conn->is_redirect_stream, conn->redirect_sse_count,
-                         conn->redirect_sse_start)) {
-          reset_stream(conn->is_redirect_stream, conn->redirect_stream_id, conn->redirect_sse_count,
-                       conn->redirect_sse_start);
-          loop_.update_fd(conn->fd, conn->events);
-          return;
-        }
-      }
+    if (conn->send_queue.empty()) {
+      // SSE frames held back while this connection was backed up.
+      sse_broadcaster_->on_drained(conn);
+      // Anything left in the scheduler is waiting for WINDOW_UPDATE.
+      conn->events = conn->write_buf.empty() ? EventMask::Read : EventMask::Read | EventMask::Write;
       loop_.update_fd(conn->fd, conn->events);
     } else {
       conn->events = EventMask::Read | EventMask::Write;
@@ -0,0 +1,31 @@
+#include "spin/http2_listener_helpers.h++"
+
+#include <algorithm>
+#include <vector>
+
+namespace neonsignal {
+
+void append_data_frames(std::vector<std::uint8_t> &out, std::uint32_t stream_id,
+                        std::span<const std::uint8_t> body) {
+  // Handle empty body case
+  if (body.empty()) {
+    append_frame_header(out, 0, 0x0 /* DATA */, 0x1 /* END_STREAM */, stream_id);
+    return;
+  }
+
+  // HTTP/2 default max frame size is 16384. Chunk DATA frames accordingly.
+  constexpr std::size_t MAX_FRAME_SIZE = 16384;
+  out.reserve(out.size() + body.size() + 9 * (body.size() / MAX_FRAME_SIZE + 1));
+  std::size_t offset = 0;
+  while (offset < body.size()) {
+    const std::size_t chunk_size = std::min(MAX_FRAME_SIZE, body.size() - offset);
+    const bool is_last = (offset + chunk_size >= body.size());
+    append_frame_header(out, static_cast<std::uint32_t>(chunk_size), 0x0 /* DATA */,
+                        is_last ? 0x1 /* END_STREAM */ : 0x0, stream_id);
+    out.insert(out.end(), body.begin() + static_cast<long>(offset),
+               body.begin() + static_cast<long>(offset + chunk_size));
+    offset += chunk_size;
+  }
+}
+
+} // namespace neonsignal
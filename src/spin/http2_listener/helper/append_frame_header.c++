@@ -0,0 +1,25 @@
+#include "spin/http2_listener_helpers.h++"
+
+#include <vector>
+
+namespace neonsignal {
+
+void append_frame_header(std::vector<std::uint8_t> &out, std::uint32_t length,
+                         std::uint8_t type, std::uint8_t flags, std::uint32_t stream_id) {
+  // Length field: 24 bits, network byte order.
+  out.push_back(static_cast<std::uint8_t>((length >> 16) & 0xFF));
+  out.push_back(static_cast<std::uint8_t>((length >> 8) & 0xFF));
+  out.push_back(static_cast<std::uint8_t>(length & 0xFF));
+
+  // Type and flags.
+  out.push_back(type);
+  out.push_back(flags);
+
+  // Stream ID: 31 bits (highest bit must be 0).
+  out.push_back(static_cast<std::uint8_t>((stream_id >> 24) & 0x7F));
+  out.push_back(static_cast<std::uint8_t>((stream_id >> 16) & 0xFF));
+  out.push_back(static_cast<std::uint8_t>((stream_id >> 8) & 0xFF));
+  out.push_back(static_cast<std::uint8_t>(stream_id & 0xFF));
+}
+
+} // namespace neonsignal
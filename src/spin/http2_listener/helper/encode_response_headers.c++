@@ -0,0 +1,38 @@
+#include "spin/http2_listener_helpers.h++"
+
+#include <string>
+#include <vector>
+
+namespace neonsignal {
+
+void encode_response_headers(
+    std::vector<std::uint8_t> &block, int status, std::string_view content_type,
+    const std::vector<std::pair<std::string, std::string>> &extra_headers) {
+  // :status
+  if (status == 200) {
+    block.push_back(0x88); // Indexed :status 200 (static table index 8)
+  } else if (status == 304) {
+    block.push_back(0x8B); // Indexed :status 304 (static table index 11)
+  } else if (status == 404) {
+    block.push_back(0x8D); // Indexed :status 404 (static table index 13)
+  } else if (status == 500) {
+    block.push_back(0x8E); // Indexed :status 500 (static table index 14)
+  } else {
+    // Literal :status with the given code using the :status name from static table.
+    encode_literal_header_no_index(block, 8, std::to_string(status));
+  }
+
+  // content-type
+  if (!content_type.empty()) {
+    encode_literal_header_no_index(block, 31, content_type);
+  }
+
+  for (const auto &[name, value] : extra_headers) {
+    // Literal header without indexing, literal name (H=0).
+    block.push_back(0x00);
+    encode_string(block, name);
+    encode_string(block, value);
+  }
+}
+
+} // namespace neonsignal
@@ -8,23 +8,20 @@
 
 namespace neonsignal {
 
-StaticResult load_static(std::string_view path, const Router& router,
-                         StaticFileCache* cache) {
-  StaticResult res;
+namespace {
 
-  // Check cache first if available
-  if (cache) {
-    auto cached = cache->get(path);
-    if (cached) {
-      res.status = 200;
-      res.content_type = cached->mime_type;
-      res.body = cached->content;
-      return res;
-    }
+// Cache keys ignore the query string so cache-busting URLs share one entry.
+std::string_view cache_key(std::string_view path) {
+  if (auto query = path.find('?'); query != std::string_view::npos) {
+    return path.substr(0, query);
   }
+  return path;
+}
+
+StaticResult load_resolved(std::string_view path, const RouteResult& route,
+                           StaticFileCache* cache, EncodingMask accepted) {
+  StaticResult res;
 
-  // Cache miss or no cache - load from disk
-  auto route = router.resolve(path);
   if (!route.found) {
     res.status = 404;
     res.body.assign({'N', 'o', 't', ' ', 'f', 'o', 'u', 'n', 'd'});
@@ -41,10 +38,24 @@ StaticResult load_static(std::string_view path, const Router& router,
     return res;
   }
 
-  res.body.resize(static_cast<std::size_t>(size));
+  // Too large to cache: leave the body on disk and stream it.
+  if (size > (cache ? cache->max_entry_bytes() : kStreamFileBytes)) {
+    res.status = 200;
+    res.content_type = guess_content_type(full);
+    res.stream_file = std::move(full);
+    res.stream_size = size;
+    return res;
+  }
+
+  // Armed before the read so a deploy landing mid-read still invalidates it.
+  if (cache) {
+    cache->watch(full);
+  }
+
+  std::vector<std::uint8_t> content(static_cast<std::size_t>(size));
   std::ifstream in(full, std::ios::binary);
-  if (!in.read(reinterpret_cast<char*>(res.body.data()),
-               static_cast<std::streamsize>(res.body.size()))) {
+  if (!in.read(reinterpret_cast<char*>(content.data()),
+               static_cast<std::streamsize>(content.size()))) {
     res.status = 500;
     res.body.assign({'E', 'r', 'r', 'o', 'r'});
     return res;
@@ -52,44 +63,54 @@ StaticResult load_static(std::string_view path, const Router& router,
 
   res.status = 200;
   res.content_type = guess_content_type(full);
+
+  // Keep it for the next request.
+  if (cache && cache->put(cache_key(path), full, content, res.content_type)) {
+    // Variants are already attached when built without an executor.
+    res.cached = cache->get(cache_key(path), accepted);
+  }
+  if (!res.cached) {
+    res.body = std::move(content);
+  }
   return res;
 }
 
-StaticResult load_static_vhost(std::string_view path,
-                               const std::filesystem::path& document_root,
-                               const Router& router) {
+StaticResult from_cache(const std::shared_ptr<const CachedFile>& cached) {
   StaticResult res;
+  res.status = 200;
+  res.content_type = cached->mime_type;
+  res.cached = cached;
+  res.cache_hit = true;
+  return res;
+}
 
-  // Resolve using custom document root
-  auto route = router.resolve(path, document_root);
-  if (!route.found) {
-    res.status = 404;
-    res.body.assign({'N', 'o', 't', ' ', 'f', 'o', 'u', 'n', 'd'});
-    return res;
-  }
-
-  std::filesystem::path full = route.file;
+} // namespace
 
-  std::error_code ec;
-  auto size = std::filesystem::file_size(full, ec);
-  if (ec) {
-    res.status = 404;
-    res.body.assign({'N', 'o', 't', ' ', 'f', 'o', 'u', 'n', 'd'});
-    return res;
+StaticResult load_static(std::string_view path, const Router& router,
+                         StaticFileCache* cache, EncodingMask accepted) {
+  // Check cache first if available
+  if (cache) {
+    if (auto cached = cache->get(cache_key(path), accepted)) {
+      return from_cache(cached);
+    }
   }
 
-  res.body.resize(static_cast<std::size_t>(size));
-  std::ifstream in(full, std::ios::binary);
-  if (!in.read(reinterpret_cast<char*>(res.body.data()),
-               static_cast<std::streamsize>(res.body.size()))) {
-    res.status = 500;
-    res.body.assign({'E', 'r', 'r', 'o', 'r'});
-    return res;
+  // Cache miss or no cache - load from disk
+  return load_resolved(path, router.resolve(path), cache, accepted);
+}
+
+StaticResult load_static_vhost(std::string_view path,
+                               const std::filesystem::path& document_root,
+                               const Router& router, StaticFileCache* cache,
+                               EncodingMask accepted) {
+  if (cache) {
+    if (auto cached = cache->get(cache_key(path), accepted)) {
+      return from_cache(cached);
+    }
   }
 
-  res.status = 200;
-  res.content_type = guess_content_type(full);
-  return res;
+  // Resolve using custom document root
+  return load_resolved(path, router.resolve(path, document_root), cache, accepted);
 }
 
 } // namespace neonsignal
@@ -7,8 +7,9 @@
 namespace neonsignal {
 
 void Http2Listener::shutdown_graceful() {
-  // Stop the redirect monitor timer
+  // Stop the redirect monitor and SSE timers
   stop_redirect_monitor_();
+  sse_broadcaster_->stop();
 
   // Stop the connection timeout timer
   if (timeout_timer_id_ != -1) {
@@ -19,6 +20,9 @@ void Http2Listener::shutdown_graceful() {
     loop_.cancel_timer(mail_cookie_timer_id_);
     mail_cookie_timer_id_ = -1;
   }
+  if (is_primary_() && static_caches_.watch_fd() >= 0) {
+    loop_.remove_fd(static_caches_.watch_fd());
+  }
 
   // Stop accepting new connections
   if (listen_fd_ != -1) {
@@ -0,0 +1,60 @@
+#include "spin/http2_listener.h++"
+#include "spin/http2_listener_helpers.h++"
+
+#include <chrono>
+#include <ctime>
+#include <string>
+
+namespace neonsignal {
+
+void Http2Listener::start_sse_channels_() {
+  using Channel = SSEBroadcaster::Channel;
+  using Backpressure = SSEBroadcaster::Backpressure;
+  using namespace std::chrono_literals;
+
+  // Counters are cheap to read, so poll often and only send changes.
+  sse_broadcaster_->set_channel(Channel::Events, {250ms, Backpressure::Coalesce, true}, [this]() {
+    return "data: {\"files_served\": " + std::to_string(served_files_.load()) +
+           ",\"page_views\": " + std::to_string(page_views_.load()) + "}\n\n";
+  });
+
+  // Process CPU time over wall time since the previous sample.
+  sse_broadcaster_->set_channel(
+      Channel::CPUMetrics, {5s, Backpressure::Drop, false},
+      [last_cpu_ns = std::uint64_t{0}, last_wall = std::chrono::steady_clock::time_point{}]() mutable {
+        timespec ts{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+        std::uint64_t cpu_now = static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull +
+                                static_cast<std::uint64_t>(ts.tv_nsec);
+        auto wall_now = std::chrono::steady_clock::now();
+        double percent = 0.0;
+        if (last_cpu_ns != 0) {
+          auto cpu_delta = cpu_now - last_cpu_ns;
+          auto wall_delta =
+              std::chrono::duration_cast<std::chrono::nanoseconds>(wall_now - last_wall).count();
+          if (wall_delta > 0) {
+            percent = (static_cast<double>(cpu_delta) / static_cast<double>(wall_delta)) * 100.0;
+          }
+        }
+        last_cpu_ns = cpu_now;
+        last_wall = wall_now;
+        return "data: {\"cpu_percent\": " + std::to_string(percent) + "}\n\n";
+      });
+
+  sse_broadcaster_->set_channel(Channel::MemMetrics, {1min, Backpressure::Drop, false}, []() {
+    return "data: {\"rss_kb\": " + std::to_string(read_rss_kb()) + "}\n\n";
+  });
+
+  sse_broadcaster_->set_channel(Channel::Redirect, {1s, Backpressure::Coalesce, true}, [this]() {
+    return "data: {\"redirect_ok\": " + std::string(redirect_service_ok_.load() ? "true" : "false") +
+           "}\n\n";
+  });
+
+  sse_broadcaster_->set_channel(Channel::Metrics, {1s, Backpressure::Coalesce, true}, [this]() {
+    return "data: " + metrics_.registry.json() + "\n\n";
+  });
+
+  sse_broadcaster_->start();
+}
+
+} // namespace neonsignal
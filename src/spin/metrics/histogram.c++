@@ -0,0 +1,70 @@
+#include "spin/metrics.h++"
+
+#include <algorithm>
+#include <bit>
+
+namespace neonsignal {
+
+std::size_t Histogram::bucket_index(std::uint64_t us) {
+  if (us < kSubBuckets) {
+    return static_cast<std::size_t>(us);
+  }
+  const unsigned exponent = static_cast<unsigned>(std::bit_width(us)) - 1;
+  if (exponent > kMaxExponent) {
+    return kBucketCount - 1;
+  }
+  const auto sub = (us >> (exponent - kSubBucketBits)) - kSubBuckets;
+  return static_cast<std::size_t>(exponent - kSubBucketBits + 1) * kSubBuckets +
+         static_cast<std::size_t>(sub);
+}
+
+std::uint64_t Histogram::bucket_lower_bound(std::size_t index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+  const auto exponent = static_cast<unsigned>(index / kSubBuckets) + kSubBucketBits - 1;
+  const auto sub = static_cast<std::uint64_t>(index % kSubBuckets);
+  return (kSubBuckets + sub) << (exponent - kSubBucketBits);
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+  Snapshot snap;
+  for (const auto& shard : shards_) {
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+      snap.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+    }
+    snap.sum_us += shard.sum_us.load(std::memory_order_relaxed);
+  }
+  for (auto n : snap.buckets) {
+    snap.count += n;
+  }
+  return snap;
+}
+
+std::uint64_t Histogram::Snapshot::percentile(double q) const {
+  if (count == 0) {
+    return 0;
+  }
+  q = std::clamp(q, 0.0, 1.0);
+  const auto rank = std::max<std::uint64_t>(
+      1, static_cast<std::uint64_t>(q * static_cast<double>(count) + 0.5));
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < kBucketCount; ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return bucket_lower_bound(i);
+    }
+  }
+  return max();
+}
+
+std::uint64_t Histogram::Snapshot::max() const {
+  for (std::size_t i = kBucketCount; i-- > 0;) {
+    if (buckets[i] != 0) {
+      return bucket_lower_bound(i);
+    }
+  }
+  return 0;
+}
+
+} // namespace neonsignal
@@ -0,0 +1,63 @@
+#include "spin/metrics.h++"
+
+#include <format>
+
+namespace neonsignal {
+
+namespace {
+
+// Series key as it appears in the exposition format, quotes escaped for JSON
+void append_key(std::string& out, std::string_view name, std::string_view labels) {
+  out += '"';
+  out += name;
+  if (!labels.empty()) {
+    out += '{';
+    for (char c : labels) {
+      if (c == '"' || c == '\\') {
+        out += '\\';
+      }
+      out += c;
+    }
+    out += '}';
+  }
+  out += "\":";
+}
+
+} // namespace
+
+std::string MetricsRegistry::json() const {
+  std::string counters;
+  std::string gauges;
+  std::string histograms;
+  std::lock_guard lock(mutex_);
+  for (const auto& [name, family] : families_) {
+    for (const auto& series : family.series) {
+      switch (family.type) {
+      case Type::Counter:
+        counters += counters.empty() ? "" : ",";
+        append_key(counters, name, series.labels);
+        counters += std::to_string(static_cast<const Counter*>(series.instrument)->value());
+        break;
+      case Type::Gauge:
+        gauges += gauges.empty() ? "" : ",";
+        append_key(gauges, name, series.labels);
+        gauges += std::to_string(static_cast<const Gauge*>(series.instrument)->value());
+        break;
+      case Type::Histogram: {
+        auto snap = static_cast<const Histogram*>(series.instrument)->snapshot();
+        histograms += histograms.empty() ? "" : ",";
+        append_key(histograms, name, series.labels);
+        histograms += std::format(
+            "{{\"count\":{},\"p50_us\":{},\"p90_us\":{},\"p99_us\":{},\"max_us\":{}}}",
+            snap.count, snap.percentile(0.5), snap.percentile(0.9), snap.percentile(0.99),
+            snap.max());
+        break;
+      }
+      }
+    }
+  }
+  return "{\"counters\":{" + counters + "},\"gauges\":{" + gauges + "},\"histograms\":{" +
+         histograms + "}}";
+}
+
+} // namespace neonsignal
@@ -0,0 +1,76 @@
+#include "spin/metrics.h++"
+
+#include <format>
+
+namespace neonsignal {
+
+namespace {
+
+// Cumulative bounds at 1 µs .. 2^25 µs (~33 s). Each is a bucket lower bound,
+// so the counts are exact (values below the bound, at µs resolution).
+constexpr unsigned kExportedBounds = 26;
+
+void append_series(std::string& out, std::string_view name, std::string_view suffix,
+                   std::string_view labels, std::string_view extra_label) {
+  out += name;
+  out += suffix;
+  if (!labels.empty() || !extra_label.empty()) {
+    out += '{';
+    out += labels;
+    if (!labels.empty() && !extra_label.empty()) {
+      out += ',';
+    }
+    out += extra_label;
+    out += '}';
+  }
+  out += ' ';
+}
+
+} // namespace
+
+std::string MetricsRegistry::prometheus_text() const {
+  std::string out;
+  std::lock_guard lock(mutex_);
+  for (const auto& [name, family] : families_) {
+    const char* type = family.type == Type::Counter ? "counter"
+                       : family.type == Type::Gauge ? "gauge"
+                                                    : "histogram";
+    out += std::format("# HELP {} {}\n# TYPE {} {}\n", name, family.help, name, type);
+    for (const auto& series : family.series) {
+      switch (family.type) {
+      case Type::Counter:
+        append_series(out, name, "", series.labels, "");
+        out += std::format("{}\n", static_cast<const Counter*>(series.instrument)->value());
+        break;
+      case Type::Gauge:
+        append_series(out, name, "", series.labels, "");
+        out += std::format("{}\n", static_cast<const Gauge*>(series.instrument)->value());
+        break;
+      case Type::Histogram: {
+        auto snap = static_cast<const Histogram*>(series.instrument)->snapshot();
+        std::uint64_t cumulative = 0;
+        std::size_t index = 0;
+        for (unsigned k = 0; k < kExportedBounds; ++k) {
+          const std::uint64_t bound_us = std::uint64_t{1} << k;
+          for (; index < Histogram::bucket_index(bound_us); ++index) {
+            cumulative += snap.buckets[index];
+          }
+          append_series(out, name, "_bucket", series.labels,
+                        std::format("le=\"{}\"", static_cast<double>(bound_us) / 1e6));
+          out += std::format("{}\n", cumulative);
+        }
+        append_series(out, name, "_bucket", series.labels, "le=\"+Inf\"");
+        out += std::format("{}\n", snap.count);
+        append_series(out, name, "_sum", series.labels, "");
+        out += std::format("{}\n", static_cast<double>(snap.sum_us) / 1e6);
+        append_series(out, name, "_count", series.labels, "");
+        out += std::format("{}\n", snap.count);
+        break;
+      }
+      }
+    }
+  }
+  return out;
+}
+
+} // namespace neonsignal
@@ -0,0 +1,75 @@
+#include "spin/metrics.h++"
+
+#include <stdexcept>
+
+namespace neonsignal {
+
+void* MetricsRegistry::find_or_add_(Type type, std::string_view name, std::string_view help,
+                                    std::string_view labels) {
+  std::lock_guard lock(mutex_);
+  auto it = families_.find(name);
+  if (it == families_.end()) {
+    it = families_.emplace(std::string(name), Family{type, std::string(help), {}}).first;
+  } else if (it->second.type != type) {
+    throw std::logic_error("metric registered with two types: " + std::string(name));
+  }
+  auto& family = it->second;
+  for (const auto& series : family.series) {
+    if (series.labels == labels) {
+      return series.instrument;
+    }
+  }
+  void* instrument = nullptr;
+  switch (type) {
+  case Type::Counter:
+    instrument = &counters_.emplace_back();
+    break;
+  case Type::Gauge:
+    instrument = &gauges_.emplace_back();
+    break;
+  case Type::Histogram:
+    instrument = &histograms_.emplace_back();
+    break;
+  }
+  family.series.push_back({std::string(labels), instrument});
+  return instrument;
+}
+
+Counter& MetricsRegistry::counter(std::string_view name, std::string_view help,
+                                  std::string_view labels) {
+  return *static_cast<Counter*>(find_or_add_(Type::Counter, name, help, labels));
+}
+
+Gauge& MetricsRegistry::gauge(std::string_view name, std::string_view help,
+                              std::string_view labels) {
+  return *static_cast<Gauge*>(find_or_add_(Type::Gauge, name, help, labels));
+}
+
+Histogram& MetricsRegistry::histogram(std::string_view name, std::string_view help,
+                                      std::string_view labels) {
+  return *static_cast<Histogram*>(find_or_add_(Type::Histogram, name, help, labels));
+}
+
+std::string MetricsRegistry::label(std::string_view key, std::string_view value) {
+  std::string out(key);
+  out += "=\"";
+  for (char c : value) {
+    switch (c) {
+    case '\\':
+      out += "\\\\";
+      break;
+    case '"':
+      out += "\\\"";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    default:
+      out += c;
+    }
+  }
+  out += '"';
+  return out;
+}
+
+} // namespace neonsignal
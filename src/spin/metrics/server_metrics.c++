@@ -0,0 +1,73 @@
+#include "spin/metrics.h++"
+
+#include <string>
+
+namespace neonsignal {
+
+namespace {
+
+constexpr std::string_view kRequests = "neonsignal_requests_total";
+constexpr std::string_view kResponses = "neonsignal_responses_total";
+constexpr std::string_view kConnections = "neonsignal_connections";
+constexpr std::string_view kWriteBuffer = "neonsignal_write_buffer_bytes";
+constexpr std::string_view kHandshakes = "neonsignal_tls_handshakes_total";
+
+// Codes the server actually sends; anything else is counted as code="other".
+constexpr int kKnownStatuses[] = {200, 201, 204, 206, 301, 302, 304, 307, 308, 400, 401,
+                                  403, 404, 405, 409, 413, 416, 429, 500, 502, 503};
+
+} // namespace
+
+ServerMetrics::ServerMetrics(MetricsRegistry& registry)
+    : registry(registry),
+      tls_handshake(registry.histogram("neonsignal_tls_handshake_seconds",
+                                       "TCP accept to completed TLS handshake")),
+      tls_full_handshakes(registry.counter(kHandshakes, "Completed TLS handshakes",
+                                           MetricsRegistry::label("resumed", "false"))),
+      tls_resumed_handshakes(registry.counter(kHandshakes, "Completed TLS handshakes",
+                                              MetricsRegistry::label("resumed", "true"))),
+      ktls_connections(registry.counter("neonsignal_ktls_connections_total",
+                                        "Connections sending through kernel TLS")),
+      first_byte(registry.histogram("neonsignal_first_byte_seconds",
+                                    "Request HEADERS to first response bytes written")),
+      pool_task_wait(registry.histogram("neonsignal_pool_task_wait_seconds",
+                                        "Time tasks spend queued for a worker thread")),
+      pool_queue_depth(registry.gauge("neonsignal_pool_queue_depth",
+                                      "Tasks waiting for a worker thread")),
+      static_cache_hits(registry.counter("neonsignal_cache_hits_total", "Cache lookups served",
+                                         MetricsRegistry::label("cache", "static"))),
+      static_cache_misses(registry.counter("neonsignal_cache_misses_total",
+                                           "Cache lookups that went to disk or the database",
+                                           MetricsRegistry::label("cache", "static"))),
+      session_cache_hits(registry.counter("neonsignal_cache_hits_total", "Cache lookups served",
+                                          MetricsRegistry::label("cache", "session"))),
+      session_cache_misses(registry.counter("neonsignal_cache_misses_total",
+                                            "Cache lookups that went to disk or the database",
+                                            MetricsRegistry::label("cache", "session"))),
+      log_lines_dropped(registry.gauge("neonsignal_log_lines_dropped",
+                                       "Log lines dropped because the log ring was full")),
+      status_other_(&registry.counter(kResponses, "Responses by status code",
+                                      MetricsRegistry::label("code", "other"))) {
+  for (int status : kKnownStatuses) {
+    status_[status - 100] = &registry.counter(kResponses, "Responses by status code",
+                                              MetricsRegistry::label("code",
+                                                                     std::to_string(status)));
+  }
+}
+
+Counter& ServerMetrics::vhost_requests(std::string_view vhost) {
+  return registry.counter(kRequests, "Requests by virtual host",
+                          MetricsRegistry::label("vhost", vhost));
+}
+
+Gauge& ServerMetrics::connections(std::size_t reactor_id) {
+  return registry.gauge(kConnections, "Open connections per reactor",
+                        MetricsRegistry::label("reactor", std::to_string(reactor_id)));
+}
+
+Gauge& ServerMetrics::write_buffer_bytes(std::size_t reactor_id) {
+  return registry.gauge(kWriteBuffer, "Outbound bytes staged, queued or flow-blocked per reactor",
+                        MetricsRegistry::label("reactor", std::to_string(reactor_id)));
+}
+
+} // namespace neonsignal
@@ -0,0 +1,30 @@
+#include "spin/outbound_flow.h++"
+
+#include <fcntl.h>
+
+namespace neonsignal {
+
+bool OutboundFlow::attach_file(std::uint32_t stream_id, const std::filesystem::path& file,
+                               std::uint64_t size) {
+  int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  auto body = std::make_unique<FileBody>();
+  body->file = std::make_shared<const WriteQueue::File>(fd);
+  body->remaining = size;
+
+  if (size == 0) {
+    push_data(stream_id, nullptr, 0, 0, true);
+    return true;
+  }
+#ifdef POSIX_FADV_SEQUENTIAL
+  ::posix_fadvise(fd, 0, static_cast<off_t>(size), POSIX_FADV_SEQUENTIAL);
+#endif
+  if (!closed_streams_.contains(stream_id)) {
+    stream_(stream_id).file = std::move(body);
+  }
+  return true;
+}
+
+} // namespace neonsignal
@@ -0,0 +1,29 @@
+#include "spin/outbound_flow.h++"
+
+namespace neonsignal {
+
+void OutboundFlow::close_stream(std::uint32_t stream_id) {
+  if (auto it = streams_.find(stream_id); it != streams_.end()) {
+    for (const auto& chunk : it->second.chunks) {
+      if (!chunk.file) {
+        buffered_bytes_ -= chunk.length;
+      }
+    }
+    streams_.erase(it);
+  }
+  pending_credit_.erase(stream_id);
+  mark_closed_(stream_id);
+}
+
+void OutboundFlow::mark_closed_(std::uint32_t stream_id) {
+  // Stream ids only grow, so the set just has to outlive late writes and
+  // WINDOW_UPDATEs for recently closed streams.
+  static constexpr std::size_t kMaxClosedStreams = 1024;
+
+  if (closed_streams_.size() >= kMaxClosedStreams) {
+    closed_streams_.clear();
+  }
+  closed_streams_.insert(stream_id);
+}
+
+} // namespace neonsignal
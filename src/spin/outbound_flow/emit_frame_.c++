@@ -0,0 +1,43 @@
+#include "spin/outbound_flow.h++"
+
+#include <algorithm>
+
+namespace neonsignal {
+
+bool OutboundFlow::emit_frame_(std::uint32_t stream_id, Stream& stream, WriteQueue& queue) {
+  auto& chunk = stream.chunks.front();
+  auto allow = std::min<std::size_t>(
+      {chunk.length, static_cast<std::size_t>(std::max<std::int64_t>(stream.window, 0)),
+       static_cast<std::size_t>(std::max<std::int64_t>(connection_window_, 0)),
+       peer_max_frame_});
+  bool last = allow == chunk.length && chunk.end_stream;
+
+  WriteQueue::FrameHeader header{
+      static_cast<std::uint8_t>((allow >> 16) & 0xFF),
+      static_cast<std::uint8_t>((allow >> 8) & 0xFF),
+      static_cast<std::uint8_t>(allow & 0xFF),
+      0x0 /* DATA */,
+      static_cast<std::uint8_t>(last ? 0x1 /* END_STREAM */ : 0x0),
+      static_cast<std::uint8_t>((stream_id >> 24) & 0x7F),
+      static_cast<std::uint8_t>((stream_id >> 16) & 0xFF),
+      static_cast<std::uint8_t>((stream_id >> 8) & 0xFF),
+      static_cast<std::uint8_t>(stream_id & 0xFF)};
+  if (chunk.file) {
+    queue.push_file_frame(header, chunk.file, chunk.file_offset, allow);
+    chunk.file_offset += allow;
+  } else {
+    queue.push_frame(header, chunk.buffer, chunk.offset, allow);
+    chunk.offset += allow;
+    buffered_bytes_ -= allow;
+  }
+
+  stream.window -= static_cast<std::int64_t>(allow);
+  connection_window_ -= static_cast<std::int64_t>(allow);
+  chunk.length -= allow;
+  if (chunk.length == 0) {
+    stream.chunks.pop_front();
+  }
+  return last;
+}
+
+} // namespace neonsignal
@@ -0,0 +1,25 @@
+#include "spin/outbound_flow.h++"
+
+namespace neonsignal {
+
+bool OutboundFlow::can_send_(const Stream& stream) const {
+  if (stream.chunks.empty()) {
+    return false;
+  }
+  // An empty END_STREAM frame consumes no window.
+  return stream.chunks.front().length == 0 || (stream.window > 0 && connection_window_ > 0);
+}
+
+bool OutboundFlow::has_sendable() const {
+  for (const auto& [_, stream] : streams_) {
+    if (can_send_(stream)) {
+      return true;
+    }
+    if (stream.chunks.empty() && stream.file && stream.window > 0 && connection_window_ > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace neonsignal
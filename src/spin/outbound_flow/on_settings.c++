@@ -0,0 +1,42 @@
+#include "spin/outbound_flow.h++"
+
+namespace neonsignal {
+
+bool OutboundFlow::on_settings(const std::vector<std::uint8_t>& payload) {
+  if (payload.size() % 6 != 0) {
+    return false; // FRAME_SIZE_ERROR
+  }
+  for (std::size_t i = 0; i < payload.size(); i += 6) {
+    std::uint16_t id = static_cast<std::uint16_t>((payload[i] << 8) | payload[i + 1]);
+    std::uint32_t value = (static_cast<std::uint32_t>(payload[i + 2]) << 24) |
+                          (static_cast<std::uint32_t>(payload[i + 3]) << 16) |
+                          (static_cast<std::uint32_t>(payload[i + 4]) << 8) | payload[i + 5];
+    switch (id) {
+    case 0x4: { // SETTINGS_INITIAL_WINDOW_SIZE: applies to every open stream
+      if (value > kMaxWindow) {
+        return false; // FLOW_CONTROL_ERROR
+      }
+      auto delta = static_cast<std::int64_t>(value) - peer_initial_window_;
+      for (auto& [_, stream] : streams_) {
+        stream.window += delta;
+        if (stream.window > kMaxWindow) {
+          return false;
+        }
+      }
+      peer_initial_window_ = value;
+      break;
+    }
+    case 0x5: // SETTINGS_MAX_FRAME_SIZE
+      if (value < kDefaultMaxFrame || value > 0xFF'FFFF) {
+        return false; // PROTOCOL_ERROR
+      }
+      peer_max_frame_ = value;
+      break;
+    default:
+      break;
+    }
+  }
+  return true;
+}
+
+} // namespace neonsignal
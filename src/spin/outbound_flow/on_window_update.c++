@@ -0,0 +1,44 @@
+#include "spin/outbound_flow.h++"
+
+namespace neonsignal {
+
+bool OutboundFlow::on_window_update(std::uint32_t stream_id, std::uint32_t increment) {
+  // Bounds credit held for streams whose response never comes (HEADERS-only
+  // responses close without ever creating stream state).
+  static constexpr std::size_t kMaxPendingCredit = 1024;
+
+  if (stream_id == 0) {
+    if (increment == 0) {
+      return false; // PROTOCOL_ERROR
+    }
+    connection_window_ += increment;
+    return connection_window_ <= kMaxWindow;
+  }
+
+  if (increment == 0 || closed_streams_.contains(stream_id)) {
+    // Stream-level error, or a closed stream: nothing to schedule.
+    return true;
+  }
+
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end()) {
+    // Open, but its response is not queued yet (async handlers): keep the
+    // credit until stream_() creates it.
+    if (pending_credit_.size() >= kMaxPendingCredit && !pending_credit_.contains(stream_id)) {
+      pending_credit_.clear();
+    }
+    auto& credit = pending_credit_[stream_id];
+    credit += increment;
+    if (peer_initial_window_ + credit > kMaxWindow) {
+      close_stream(stream_id);
+    }
+    return true;
+  }
+  it->second.window += increment;
+  if (it->second.window > kMaxWindow) {
+    close_stream(stream_id);
+  }
+  return true;
+}
+
+} // namespace neonsignal
@@ -0,0 +1,56 @@
+#include "spin/outbound_flow.h++"
+
+namespace neonsignal {
+
+void OutboundFlow::pump(WriteQueue& queue, std::size_t budget) {
+  std::vector<std::uint32_t> order;
+  while (queue.bytes() < budget && !streams_.empty()) {
+    // One round: every stream gets at most one frame, starting after the
+    // stream served last so a large body cannot starve the others.
+    order.clear();
+    for (auto it = streams_.upper_bound(next_stream_); it != streams_.end(); ++it) {
+      order.push_back(it->first);
+    }
+    for (auto it = streams_.begin(); it != streams_.end() && it->first <= next_stream_; ++it) {
+      order.push_back(it->first);
+    }
+
+    bool progressed = false;
+    for (auto stream_id : order) {
+      if (queue.bytes() >= budget) {
+        break;
+      }
+      auto it = streams_.find(stream_id);
+      if (it == streams_.end()) {
+        continue;
+      }
+      if (!refill_(it->second)) {
+        // Abort the response: RST_STREAM with INTERNAL_ERROR.
+        std::vector<std::uint8_t> rst{0x00, 0x00, 0x04, 0x03, 0x00,
+                                      static_cast<std::uint8_t>((stream_id >> 24) & 0x7F),
+                                      static_cast<std::uint8_t>((stream_id >> 16) & 0xFF),
+                                      static_cast<std::uint8_t>((stream_id >> 8) & 0xFF),
+                                      static_cast<std::uint8_t>(stream_id & 0xFF),
+                                      0x00, 0x00, 0x00, 0x02};
+        queue.push(std::move(rst));
+        close_stream(stream_id);
+        progressed = true;
+        continue;
+      }
+      if (!can_send_(it->second)) {
+        continue;
+      }
+      next_stream_ = stream_id;
+      progressed = true;
+      if (emit_frame_(stream_id, it->second, queue)) {
+        streams_.erase(it);
+        mark_closed_(stream_id);
+      }
+    }
+    if (!progressed) {
+      break;
+    }
+  }
+}
+
+} // namespace neonsignal
@@ -0,0 +1,26 @@
+#include "spin/outbound_flow.h++"
+
+namespace neonsignal {
+
+OutboundFlow::Stream& OutboundFlow::stream_(std::uint32_t stream_id) {
+  auto [it, inserted] = streams_.try_emplace(stream_id);
+  if (inserted) {
+    it->second.window = peer_initial_window_;
+    if (auto credit = pending_credit_.find(stream_id); credit != pending_credit_.end()) {
+      it->second.window += credit->second;
+      pending_credit_.erase(credit);
+    }
+  }
+  return it->second;
+}
+
+void OutboundFlow::push_data(std::uint32_t stream_id, Buffer buffer, std::size_t offset,
+                             std::size_t length, bool end_stream) {
+  if (closed_streams_.contains(stream_id) || (length == 0 && !end_stream)) {
+    return;
+  }
+  stream_(stream_id).chunks.push_back({std::move(buffer), offset, length, end_stream, nullptr, 0});
+  buffered_bytes_ += length;
+}
+
+} // namespace neonsignal
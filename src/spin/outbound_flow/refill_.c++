@@ -0,0 +1,53 @@
+#include "spin/outbound_flow.h++"
+
+#include <algorithm>
+#include <cerrno>
+
+#include <unistd.h>
+
+namespace neonsignal {
+
+bool OutboundFlow::refill_(Stream& stream) {
+  if (!stream.chunks.empty() || !stream.file || stream.window <= 0 || connection_window_ <= 0) {
+    return true;
+  }
+  auto& file = *stream.file;
+  if (sendfile_) {
+    // The whole remainder becomes one file-backed chunk; emit_frame_() cuts
+    // it into frames as the windows allow, without reading anything.
+    stream.chunks.push_back({nullptr, 0, static_cast<std::size_t>(file.remaining), true,
+                             file.file, file.offset});
+    stream.file.reset();
+    return true;
+  }
+  auto want = static_cast<std::size_t>(
+      std::min<std::uint64_t>(file.remaining, kFileChunkBytes));
+  auto data = std::make_shared<std::vector<std::uint8_t>>(want);
+
+  std::size_t got = 0;
+  while (got < want) {
+    auto n = ::pread(file.file->fd, data->data() + got, want - got,
+                     static_cast<off_t>(file.offset + got));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      // Read error or the file shrank under us: the promised
+      // content-length can no longer be met.
+      return false;
+    }
+    got += static_cast<std::size_t>(n);
+  }
+
+  file.offset += want;
+  file.remaining -= want;
+  bool end_stream = file.remaining == 0;
+  stream.chunks.push_back({std::move(data), 0, want, end_stream, nullptr, 0});
+  buffered_bytes_ += want;
+  if (end_stream) {
+    stream.file.reset();
+  }
+  return true;
+}
+
+} // namespace neonsignal
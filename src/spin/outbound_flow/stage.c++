@@ -0,0 +1,41 @@
+#include "spin/outbound_flow.h++"
+
+namespace neonsignal {
+
+void OutboundFlow::stage(std::vector<std::uint8_t>& frames, WriteQueue& queue) {
+  if (frames.empty()) {
+    return;
+  }
+  auto buffer = std::make_shared<const std::vector<std::uint8_t>>(std::move(frames));
+  frames.clear();
+  const auto& bytes = *buffer;
+
+  // Control frames are passed through as runs of the staged buffer; DATA
+  // payloads are held back for the scheduler.
+  std::size_t run_start = 0;
+  std::size_t pos = 0;
+  while (pos + 9 <= bytes.size()) {
+    std::size_t len = (static_cast<std::size_t>(bytes[pos]) << 16) |
+                      (static_cast<std::size_t>(bytes[pos + 1]) << 8) | bytes[pos + 2];
+    if (pos + 9 + len > bytes.size()) {
+      break;
+    }
+    std::uint8_t type = bytes[pos + 3];
+    std::uint8_t flags = bytes[pos + 4];
+    std::uint32_t stream_id = ((bytes[pos + 5] & 0x7Fu) << 24) | (bytes[pos + 6] << 16) |
+                              (bytes[pos + 7] << 8) | bytes[pos + 8];
+
+    if (type == 0x0 /* DATA */) {
+      queue.push(buffer, run_start, pos - run_start);
+      push_data(stream_id, buffer, pos + 9, len, (flags & 0x1) != 0);
+      run_start = pos + 9 + len;
+    } else if (type == 0x3 /* RST_STREAM */) {
+      // Data still waiting for window must not follow the reset.
+      close_stream(stream_id);
+    }
+    pos += 9 + len;
+  }
+  queue.push(buffer, run_start, bytes.size() - run_start);
+}
+
+} // namespace neonsignal
@@ -1,3 +1,4 @@
+#include "neonsignal/logging.h++"
 #include "spin/event_loop.h++"
 #include "spin/redirect_service.h++"
 
@@ -12,14 +13,16 @@ void RedirectService::close_connection_(const int fd) {
   loop_.remove_fd(fd);
   if (const auto it = connections_.find(fd); it != connections_.end()) {
     // Known connection: close the tracked socket and erase its state.
-    if (!it->second.buffer.empty()) {
+    if (!it->second.buffer.empty() && log_enabled(LogLevel::debug)) {
       std::cerr << "• redirect: closing tracked fd=" << it->second.fd << '\n';
     }
     close(it->second.fd);
     connections_.erase(it);
   } else {
     // Safety: close untracked fd to avoid leaks.
-    std::cerr << "• redirect: closing untracked fd=" << fd << '\n';
+    if (log_enabled(LogLevel::debug)) {
+      std::cerr << "• redirect: closing untracked fd=" << fd << '\n';
+    }
     close(fd);
   }
 }
@@ -1,5 +1,6 @@
 #include "spin/redirect_service.h++"
 
+#include "neonsignal/logging.h++"
 #include "spin/event_mask.h++"
 #include "spin/socket_utils.h++"
 
@@ -34,7 +35,9 @@ void RedirectService::handle_io_(const int fd, const std::uint32_t events) {
       // need the request headers.
 
       if (const ssize_t n = recv(fd, buf, sizeof(buf), 0); n > 0) {
-        std::cerr << "• redirect: reading headers fd=" << fd << '\n';
+        if (log_enabled(LogLevel::debug)) {
+          std::cerr << "• redirect: reading headers fd=" << fd << '\n';
+        }
         conn.buffer.append(buf, static_cast<std::size_t>(n));
 
         if (conn.buffer.size() > 32768) {
@@ -44,7 +47,7 @@ void RedirectService::handle_io_(const int fd, const std::uint32_t events) {
         }
       } else if (n == 0) {
         // Client closed.
-        if (!conn.buffer.empty()) {
+        if (!conn.buffer.empty() && log_enabled(LogLevel::debug)) {
           std::cerr << "• redirect: client closed fd=" << fd << '\n';
         }
         close_connection_(fd);
@@ -85,7 +88,9 @@ void RedirectService::handle_io_(const int fd, const std::uint32_t events) {
 
     if (conn.write_buffer.empty()) {
       // After flushing the redirect, close to keep things simple.
-      std::cerr << "• redirect: response flushed fd=" << fd << ", closing\n";
+      if (log_enabled(LogLevel::debug)) {
+        std::cerr << "• redirect: response flushed fd=" << fd << ", closing\n";
+      }
       close_connection_(fd);
     }
   }
@@ -1,5 +1,6 @@
 #include "spin/redirect_service.h++"
 
+#include "neonsignal/logging.h++"
 #include "spin/event_mask.h++"
 
 #include <algorithm>
@@ -12,13 +13,17 @@ namespace neonsignal {
 
 void RedirectService::process_buffer_(const int fd, Connection &conn) {
   if (conn.responded) {
-    std::cerr << "• redirect: already responded fd=" << fd << '\n';
+    if (log_enabled(LogLevel::debug)) {
+      std::cerr << "• redirect: already responded fd=" << fd << '\n';
+    }
     // Redirect already queued; avoid double responses.
     return;
   }
 
   if (const auto header_end = conn.buffer.find("\r\n\r\n"); header_end == std::string::npos) {
-    std::cerr << "• redirect: waiting for full headers fd=" << fd << '\n';
+    if (log_enabled(LogLevel::debug)) {
+      std::cerr << "• redirect: waiting for full headers fd=" << fd << '\n';
+    }
     // Wait for complete headers.
     return;
   }
@@ -53,8 +58,10 @@ void RedirectService::process_buffer_(const int fd, Connection &conn) {
         // Normalize odd paths back to root.
         path = "/";
       }
-      std::cerr << "• redirect: parsed path fd=" << fd << " path=" << path << " method=" << method
-                << '\n';
+      if (log_enabled(LogLevel::debug)) {
+        std::cerr << "• redirect: parsed path fd=" << fd << " path=" << path
+                  << " method=" << method << '\n';
+      }
     }
   }
 
@@ -89,8 +96,10 @@ void RedirectService::process_buffer_(const int fd, Connection &conn) {
           }
           // Use the client-sent host when present.
           host = header_host;
-          std::cerr << "• redirect: parsed host fd=" << fd << " host=" << host
-                    << " port=" << host_port << '\n';
+          if (log_enabled(LogLevel::debug)) {
+            std::cerr << "• redirect: parsed host fd=" << fd << " host=" << host
+                      << " port=" << host_port << '\n';
+          }
         }
       }
     }
@@ -114,8 +123,10 @@ void RedirectService::process_buffer_(const int fd, Connection &conn) {
   conn.responded = true;
   // Queue the redirect and flip to EPOLLOUT to flush.
   send_redirect_(conn, host, path);
-  std::cerr << "• redirect: queued 308 fd=" << fd << " host=" << host << " port=" << host_port
-            << " method=" << method << " path=" << path << " client_port=" << client_port << '\n';
+  if (log_enabled(LogLevel::debug)) {
+    std::cerr << "• redirect: queued 308 fd=" << fd << " host=" << host << " port=" << host_port
+              << " method=" << method << " path=" << path << " client_port=" << client_port << '\n';
+  }
   loop_.update_fd(fd, EventMask::Write | EventMask::Edge);
 }
 
@@ -3,8 +3,10 @@
 
 #include <openssl/ssl.h>
 
+#include <cstdlib>
 #include <iostream>
 #include <stdexcept>
+#include <string_view>
 
 namespace {
 
@@ -48,8 +50,16 @@ namespace neonsignal {
 void Server::initialize_tls() {
   ensure_openssl_initialized();
 
+  // Kernel TLS offload is opt-in: it needs the tls module and a kTLS-enabled
+  // OpenSSL, and only pays off for large static files.
+  bool ktls = false;
+  if (const char *env_ktls = std::getenv("NEONSIGNAL_KTLS")) {
+    std::string_view value(env_ktls);
+    ktls = value == "1" || value == "true" || value == "on";
+  }
+
   // Initialize the CertManager and load all certificates
-  cert_manager_ = std::make_unique<CertManager>(config_.certs_root);
+  cert_manager_ = std::make_unique<CertManager>(config_.certs_root, ktls);
   if (!cert_manager_->initialize()) {
     throw std::runtime_error(
         "failed to initialize certificate manager from " + config_.certs_root);
@@ -69,6 +79,11 @@ void Server::initialize_tls() {
   SSL_CTX_set_tlsext_servername_callback(default_ctx, sni_callback);
   SSL_CTX_set_tlsext_servername_arg(default_ctx, cert_manager_.get());
 
+  if (ktls) {
+    std::cerr << "• neonsignal->kTLS requested: file bodies use SSL_sendfile when the kernel "
+                 "accepts the cipher\n";
+  }
+
   // Log loaded certificates
   std::cerr << "• neonsignal->TLS certificates loaded:\n";
   for (const auto &cert : cert_manager_->list_certificates()) {
@@ -2,11 +2,15 @@
 
 #include "spin/event_loop.h++"
 #include "spin/http2_listener.h++"
+#include "spin/platform_utils.h++"
 #include "spin/router.h++"
+#include "spin/shared_state.h++"
 #include "spin/thread_pool.h++"
 
 #include <csignal>
 #include <cstdlib>
+#include <format>
+#include <functional>
 #include <iostream>
 #include <stdexcept>
 #include <thread>
@@ -61,19 +65,67 @@ void Server::run() {
   if (thread_count == 0) {
     thread_count = 2;
   }
+  // Reactors: each owns an EventLoop, an SO_REUSEPORT listen socket and its own
+  // connection/SSE shards. The kernel balances accepts across the sockets.
+  std::size_t reactor_count = 1;
+  if (const char *env_reactors = std::getenv("NEONSIGNAL_REACTORS")) {
+    try {
+      unsigned long v = std::stoul(env_reactors);
+      if (v > 0) {
+        reactor_count = static_cast<std::size_t>(v);
+      }
+    } catch (...) {
+    }
+  }
+
   ThreadPool::ServerHostPort server_host_port = {.host = config_.host, .port = config_.port};
   pool_ = std::make_unique<ThreadPool>(thread_count, server_host_port);
-  loop_ = std::make_unique<EventLoop>();
   router_ = std::make_unique<Router>(config_.www_root);
-  listener_ = std::make_unique<Http2Listener>(*loop_, *pool_, ssl_ctx_.get(), config_, *router_,
-                                              served_files_, page_views_, event_clients_);
-  listener_->start();
+  shared_ = std::make_unique<SharedState>(config_);
+  pool_->set_metrics(&shared_->metrics.pool_queue_depth, &shared_->metrics.pool_task_wait);
+  // Compressed static variants are built on the worker pool
+  shared_->static_caches->set_executor(
+      [pool = pool_.get()](std::function<void()> task) { pool->enqueue(std::move(task)); });
 
-  // Graceful shutdown on SIGINT/SIGTERM using portable signal handling
-  loop_->add_signal(SIGINT, [this]() { stop(); });
-  loop_->add_signal(SIGTERM, [this]() { stop(); });
+  loops_.reserve(reactor_count);
+  listeners_.reserve(reactor_count);
+  for (std::size_t i = 0; i < reactor_count; ++i) {
+    loops_.push_back(std::make_unique<EventLoop>());
+    listeners_.push_back(std::make_unique<Http2Listener>(
+        *loops_[i], *pool_, ssl_ctx_.get(), config_, *router_, *shared_, served_files_,
+        page_views_, event_clients_, i, reactor_count));
+    listeners_[i]->start();
+  }
+  if (reactor_count > 1) {
+    std::cerr << "• neonsignal->" << reactor_count << " reactors on :" << config_.port << '\n';
+  }
+
+  // Graceful shutdown on SIGINT/SIGTERM using portable signal handling.
+  // Registered before spawning reactor threads so they inherit the blocked mask.
+  loops_[0]->add_signal(SIGINT, [this]() { stop(); });
+  loops_[0]->add_signal(SIGTERM, [this]() { stop(); });
+
+  reactor_threads_.reserve(reactor_count - 1);
+  for (std::size_t i = 1; i < reactor_count; ++i) {
+    reactor_threads_.emplace_back([this, i] {
+      platform_utils::set_thread_name(std::format("reactor->({})", i));
+      loops_[i]->run();
+      // stop() only flips the running flag for secondary reactors; close the
+      // listener and drain on the owning thread so neither its timers nor the
+      // backend are touched concurrently.
+      listeners_[i]->shutdown_graceful();
+      loops_[i]->shutdown_graceful();
+    });
+  }
 
-  loop_->run();
+  loops_[0]->run();
+
+  for (auto &thread : reactor_threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  reactor_threads_.clear();
 }
 
 } // namespace neonsignal
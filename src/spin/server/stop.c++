@@ -5,14 +5,19 @@
 namespace neonsignal {
 
 void Server::stop() {
-  // Stop accepting new connections first
-  if (listener_) {
-    listener_->shutdown_graceful();
+  // Runs on reactor 0. Its listener stops accepting here; secondary
+  // listeners own state their loops may be dispatching, so those reactors
+  // only get the stop flag and shut their listener down on their own thread.
+  if (!listeners_.empty()) {
+    listeners_[0]->shutdown_graceful();
+  }
+  for (std::size_t i = 1; i < loops_.size(); ++i) {
+    loops_[i]->stop();
   }
 
-  if (loop_) {
+  if (!loops_.empty()) {
     // Use graceful shutdown to drain remaining connections (3s timeout)
-    loop_->shutdown_graceful();
+    loops_[0]->shutdown_graceful();
   }
 }
 
@@ -0,0 +1,15 @@
+#include "spin/session_ticket_keys.h++"
+
+#include <mutex>
+
+namespace neonsignal {
+
+SessionTicketKeys::SessionTicketKeys() {
+  // Every slot gets random material up front so no key is ever predictable.
+  std::unique_lock lock(mutex_);
+  for (std::size_t i = 0; i < kKeyCount; ++i) {
+    rotate_locked_();
+  }
+}
+
+} // namespace neonsignal
@@ -0,0 +1,103 @@
+#include "spin/session_ticket_keys.h++"
+
+#include <cstring>
+#include <exception>
+#include <mutex>
+
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/rand.h>
+
+namespace neonsignal {
+
+namespace {
+
+int keys_index() {
+  static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  return index;
+}
+
+} // namespace
+
+void SessionTicketKeys::install(SSL_CTX* ctx) {
+  SSL_CTX_set_ex_data(ctx, keys_index(), this);
+  SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, &SessionTicketKeys::ticket_callback_);
+}
+
+int SessionTicketKeys::ticket_callback_(SSL* ssl, unsigned char* key_name, unsigned char* iv,
+                                        EVP_CIPHER_CTX* cipher, EVP_MAC_CTX* mac, int encrypt) {
+  // Tickets are handled by the context the connection was created on, which
+  // may differ from the one SNI selected; both carry the same keys.
+  auto* keys = static_cast<SessionTicketKeys*>(
+      SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), keys_index()));
+  if (!keys) {
+    return -1;
+  }
+  try {
+    return keys->seal_or_open_(key_name, iv, cipher, mac, encrypt == 1);
+  } catch (const std::exception&) {
+    return -1; // key rotation failed; OpenSSL falls back to a full handshake
+  }
+}
+
+int SessionTicketKeys::seal_or_open_(unsigned char* key_name, unsigned char* iv,
+                                     EVP_CIPHER_CTX* cipher, EVP_MAC_CTX* mac, bool encrypt) {
+  Key key;
+  bool retired = false;
+  {
+    std::shared_lock lock(mutex_);
+    if (std::chrono::steady_clock::now() - rotated_at_ >= kRotateInterval) {
+      lock.unlock();
+      std::unique_lock exclusive(mutex_);
+      if (std::chrono::steady_clock::now() - rotated_at_ >= kRotateInterval) {
+        rotate_locked_();
+      }
+      exclusive.unlock();
+      lock.lock();
+    }
+
+    if (encrypt) {
+      key = keys_[current_];
+    } else {
+      std::size_t found = kKeyCount;
+      for (std::size_t i = 0; i < kKeyCount; ++i) {
+        if (std::memcmp(keys_[i].name.data(), key_name, keys_[i].name.size()) == 0) {
+          found = i;
+          break;
+        }
+      }
+      if (found == kKeyCount) {
+        return 0; // unknown or expired key: full handshake
+      }
+      key = keys_[found];
+      retired = found != current_;
+    }
+  }
+
+  OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, key.hmac.data(), key.hmac.size()),
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>("SHA256"), 0),
+      OSSL_PARAM_construct_end()};
+
+  if (encrypt) {
+    const EVP_CIPHER* aes = EVP_aes_256_cbc();
+    if (RAND_bytes(iv, EVP_CIPHER_get_iv_length(aes)) != 1) {
+      return -1;
+    }
+    std::memcpy(key_name, key.name.data(), key.name.size());
+    if (EVP_EncryptInit_ex(cipher, aes, nullptr, key.aes.data(), iv) != 1 ||
+        EVP_MAC_CTX_set_params(mac, params) != 1) {
+      return -1;
+    }
+    return 1;
+  }
+
+  if (EVP_DecryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, key.aes.data(), iv) != 1 ||
+      EVP_MAC_CTX_set_params(mac, params) != 1) {
+    return -1;
+  }
+  // 2 asks OpenSSL to accept the ticket and issue a new one under the current key.
+  return retired ? 2 : 1;
+}
+
+} // namespace neonsignal
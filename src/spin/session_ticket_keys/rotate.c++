@@ -0,0 +1,28 @@
+#include "spin/session_ticket_keys.h++"
+
+#include <mutex>
+#include <stdexcept>
+
+#include <openssl/rand.h>
+
+namespace neonsignal {
+
+void SessionTicketKeys::rotate() {
+  std::unique_lock lock(mutex_);
+  rotate_locked_();
+}
+
+void SessionTicketKeys::rotate_locked_() {
+  std::size_t next = (current_ + 1) % kKeyCount;
+  Key key;
+  if (RAND_bytes(key.name.data(), static_cast<int>(key.name.size())) != 1 ||
+      RAND_bytes(key.aes.data(), static_cast<int>(key.aes.size())) != 1 ||
+      RAND_bytes(key.hmac.data(), static_cast<int>(key.hmac.size())) != 1) {
+    throw std::runtime_error("RAND_bytes failed generating a session ticket key");
+  }
+  keys_[next] = key;
+  current_ = next;
+  rotated_at_ = std::chrono::steady_clock::now();
+}
+
+} // namespace neonsignal
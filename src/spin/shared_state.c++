@@ -0,0 +1,19 @@
+#include "spin/shared_state.h++"
+
+#include <utility>
+
+namespace neonsignal {
+
+SharedState::SharedState(ServerConfig server_config)
+    : config(std::move(server_config)),
+      static_caches(std::make_unique<StaticCacheRegistry>()),
+      session_cache(std::make_unique<SessionCache>()),
+      db(std::make_unique<Database>(config.db_path)),
+      mail_service(std::make_unique<MailService>(*db, config.mail)),
+      mail_cookie_store(std::make_unique<MailCookieStore>(config.mail)),
+      auth(config.rp_id, config.origin, *db),
+      vhost_resolver(config.www_root) {
+  auth.load_credentials();
+}
+
+} // namespace neonsignal
@@ -0,0 +1,58 @@
+#include "spin/sse_broadcaster.h++"
+
+#include "spin/event_loop.h++"
+
+namespace neonsignal {
+
+SSEBroadcaster::SSEBroadcaster(EventLoop& loop, SSEResetPolicy policy,
+                               std::size_t max_pending_bytes,
+                               std::atomic<std::uint64_t>& event_clients)
+    : loop_(loop), policy_(policy), max_pending_bytes_(max_pending_bytes),
+      event_clients_(event_clients) {}
+
+SSEBroadcaster::~SSEBroadcaster() { stop(); }
+
+void SSEBroadcaster::set_channel(Channel channel, ChannelConfig config, Producer producer) {
+  std::lock_guard lock(mutex_);
+  auto& state = state_(channel);
+  state.config = config;
+  state.producer = std::move(producer);
+}
+
+void SSEBroadcaster::start() {
+  std::lock_guard lock(mutex_);
+  bool needs_sweep = false;
+  for (std::size_t i = 0; i < kChannelCount; ++i) {
+    auto channel = static_cast<Channel>(i);
+    auto& state = state_(channel);
+    if (!state.producer) {
+      continue;
+    }
+    needs_sweep = needs_sweep || state.config.interval > kResetSweep;
+    if (state.timer_id != -1) {
+      continue;
+    }
+    state.timer_id = loop_.add_timer(state.config.interval, [this, channel]() { tick_(channel); });
+  }
+
+  // A tick only checks max_age every interval; slower channels need the sweep.
+  if (needs_sweep && policy_.mode != SSEResetPolicy::Mode::OnlyCount && reset_timer_id_ == -1) {
+    reset_timer_id_ = loop_.add_timer(kResetSweep, [this]() { sweep_resets_(); });
+  }
+}
+
+void SSEBroadcaster::stop() {
+  std::lock_guard lock(mutex_);
+  for (auto& state : channels_) {
+    if (state.timer_id != -1) {
+      loop_.cancel_timer(state.timer_id);
+      state.timer_id = -1;
+    }
+  }
+  if (reset_timer_id_ != -1) {
+    loop_.cancel_timer(reset_timer_id_);
+    reset_timer_id_ = -1;
+  }
+}
+
+} // namespace neonsignal
@@ -0,0 +1,56 @@
+#include "spin/sse_broadcaster.h++"
+
+#include "spin/event_loop.h++"
+#include "spin/event_mask.h++"
+#include "spin/http2_listener.h++"
+
+namespace neonsignal {
+
+namespace {
+
+void patch_stream_id(std::uint8_t* frame_header, std::uint32_t stream_id) {
+  frame_header[5] = static_cast<std::uint8_t>((stream_id >> 24) & 0x7F);
+  frame_header[6] = static_cast<std::uint8_t>((stream_id >> 16) & 0xFF);
+  frame_header[7] = static_cast<std::uint8_t>((stream_id >> 8) & 0xFF);
+  frame_header[8] = static_cast<std::uint8_t>(stream_id & 0xFF);
+}
+
+} // namespace
+
+void SSEBroadcaster::deliver_(Http2Connection& conn, Subscriber& sub,
+                              const std::vector<std::uint8_t>& frame) {
+  const std::size_t base = conn.write_buf.size();
+  conn.write_buf.insert(conn.write_buf.end(), frame.begin(), frame.end());
+  patch_stream_id(conn.write_buf.data() + base, sub.stream_id);
+  ++sub.sent;
+  // Idle connections only need one epoll update per tick.
+  if (!(conn.events & EventMask::Write)) {
+    conn.events |= EventMask::Write;
+    loop_.update_fd(conn.fd, conn.events);
+  }
+}
+
+void SSEBroadcaster::end_stream_(Http2Connection& conn, std::uint32_t stream_id) {
+  std::uint8_t frame[9] = {0x00, 0x00, 0x00, 0x00 /* DATA */, 0x01 /* END_STREAM */};
+  patch_stream_id(frame, stream_id);
+  conn.write_buf.insert(conn.write_buf.end(), frame, frame + sizeof(frame));
+  if (!(conn.events & EventMask::Write)) {
+    conn.events |= EventMask::Write;
+    loop_.update_fd(conn.fd, conn.events);
+  }
+}
+
+bool SSEBroadcaster::backpressured_(const Http2Connection& conn) const {
+  return conn.pending_write_bytes() > max_pending_bytes_;
+}
+
+bool SSEBroadcaster::should_reset_(const Subscriber& sub,
+                                   std::chrono::steady_clock::time_point now) const {
+  bool time_exceeded =
+      policy_.mode != SSEResetPolicy::Mode::OnlyCount && now - sub.started >= policy_.max_age;
+  bool count_exceeded =
+      policy_.mode != SSEResetPolicy::Mode::OnlyTime && sub.sent >= policy_.max_messages;
+  return time_exceeded || count_exceeded;
+}
+
+} // namespace neonsignal
@@ -0,0 +1,40 @@
+#include "spin/sse_broadcaster.h++"
+
+#include "spin/http2_listener.h++"
+
+namespace neonsignal {
+
+void SSEBroadcaster::on_drained(const std::shared_ptr<Http2Connection>& conn) {
+  std::lock_guard lock(mutex_);
+  for (auto& state : channels_) {
+    auto it = state.subscribers.find(conn->fd);
+    if (it == state.subscribers.end()) {
+      continue;
+    }
+    for (auto& sub : it->second) {
+      if (sub.pending && !backpressured_(*conn)) {
+        auto frame = std::move(sub.pending);
+        deliver_(*conn, sub, *frame);
+      }
+    }
+  }
+}
+
+std::size_t SSEBroadcaster::subscriber_count(Channel channel) const {
+  std::lock_guard lock(mutex_);
+  std::size_t total = 0;
+  for (const auto& [_, streams] : channels_[static_cast<std::size_t>(channel)].subscribers) {
+    total += streams.size();
+  }
+  return total;
+}
+
+std::size_t SSEBroadcaster::total_subscribers() const {
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < kChannelCount; ++i) {
+    total += subscriber_count(static_cast<Channel>(i));
+  }
+  return total;
+}
+
+} // namespace neonsignal
@@ -0,0 +1,31 @@
+#include "spin/sse_broadcaster.h++"
+
+namespace neonsignal {
+
+void SSEBroadcaster::publish_(ChannelState& state, std::chrono::steady_clock::time_point now) {
+  auto payload = state.producer();
+  if (state.last_frame && state.config.skip_unchanged && payload == state.last_payload &&
+      now - state.last_published < kHeartbeat) {
+    return;
+  }
+  state.last_frame = encode_frame_(payload);
+  state.last_payload = std::move(payload);
+  state.last_published = now;
+}
+
+SSEBroadcaster::Frame SSEBroadcaster::encode_frame_(std::string_view payload) {
+  // DATA frame, no END_STREAM; the stream id is patched per subscriber.
+  auto frame = std::make_shared<std::vector<std::uint8_t>>();
+  frame->reserve(9 + payload.size());
+  const auto length = static_cast<std::uint32_t>(payload.size());
+  frame->push_back(static_cast<std::uint8_t>((length >> 16) & 0xFF));
+  frame->push_back(static_cast<std::uint8_t>((length >> 8) & 0xFF));
+  frame->push_back(static_cast<std::uint8_t>(length & 0xFF));
+  frame->push_back(0x00); // DATA
+  frame->push_back(0x00); // no flags
+  frame->insert(frame->end(), 4, 0x00);
+  frame->insert(frame->end(), payload.begin(), payload.end());
+  return frame;
+}
+
+} // namespace neonsignal
@@ -0,0 +1,71 @@
+#include "spin/sse_broadcaster.h++"
+
+#include "spin/http2_listener.h++"
+
+namespace neonsignal {
+
+void SSEBroadcaster::subscribe(Channel channel, const std::shared_ptr<Http2Connection>& conn,
+                               std::uint32_t stream_id) {
+  {
+    std::lock_guard lock(mutex_);
+    auto& state = state_(channel);
+    auto now = std::chrono::steady_clock::now();
+    if (!state.last_frame && state.producer) {
+      publish_(state, now);
+    }
+
+    Subscriber sub{conn, stream_id, now, 0, nullptr};
+    if (state.last_frame) {
+      deliver_(*conn, sub, *state.last_frame);
+    }
+    state.subscribers[conn->fd].push_back(std::move(sub));
+  }
+  if (channel == Channel::Events) {
+    ++event_clients_;
+  }
+}
+
+void SSEBroadcaster::unsubscribe_stream(int fd, std::uint32_t stream_id) {
+  for (std::size_t i = 0; i < kChannelCount; ++i) {
+    std::size_t removed = 0;
+    {
+      std::lock_guard lock(mutex_);
+      auto& subscribers = channels_[i].subscribers;
+      auto it = subscribers.find(fd);
+      if (it == subscribers.end()) {
+        continue;
+      }
+      removed = std::erase_if(it->second,
+                              [&](const Subscriber& sub) { return sub.stream_id == stream_id; });
+      if (it->second.empty()) {
+        subscribers.erase(it);
+      }
+    }
+    released_(static_cast<Channel>(i), removed);
+  }
+}
+
+void SSEBroadcaster::unsubscribe_all(int fd) {
+  for (std::size_t i = 0; i < kChannelCount; ++i) {
+    std::size_t removed = 0;
+    {
+      std::lock_guard lock(mutex_);
+      auto& subscribers = channels_[i].subscribers;
+      auto it = subscribers.find(fd);
+      if (it == subscribers.end()) {
+        continue;
+      }
+      removed = it->second.size();
+      subscribers.erase(it);
+    }
+    released_(static_cast<Channel>(i), removed);
+  }
+}
+
+void SSEBroadcaster::released_(Channel channel, std::size_t count) {
+  if (channel == Channel::Events && count > 0) {
+    event_clients_ -= count;
+  }
+}
+
+} // namespace neonsignal
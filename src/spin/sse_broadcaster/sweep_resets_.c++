@@ -0,0 +1,33 @@
+#include "spin/sse_broadcaster.h++"
+
+#include "spin/http2_listener.h++"
+
+#include <iterator>
+
+namespace neonsignal {
+
+void SSEBroadcaster::sweep_resets_() {
+  auto now = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < kChannelCount; ++i) {
+    std::size_t removed = 0;
+    {
+      std::lock_guard lock(mutex_);
+      auto& subscribers = channels_[i].subscribers;
+      for (auto it = subscribers.begin(); it != subscribers.end();) {
+        std::erase_if(it->second, [&](const Subscriber& sub) {
+          auto conn = sub.conn.lock();
+          if (!conn || conn->closed || !should_reset_(sub, now)) {
+            return false; // dead connections are left to the next tick
+          }
+          end_stream_(*conn, sub.stream_id);
+          ++removed;
+          return true;
+        });
+        it = it->second.empty() ? subscribers.erase(it) : std::next(it);
+      }
+    }
+    released_(static_cast<Channel>(i), removed);
+  }
+}
+
+} // namespace neonsignal
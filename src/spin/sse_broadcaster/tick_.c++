@@ -0,0 +1,58 @@
+#include "spin/sse_broadcaster.h++"
+
+#include "spin/http2_listener.h++"
+
+#include <iterator>
+
+namespace neonsignal {
+
+void SSEBroadcaster::tick_(Channel channel) {
+  std::size_t removed = 0;
+  {
+    std::lock_guard lock(mutex_);
+    auto& state = state_(channel);
+    if (state.subscribers.empty() || !state.producer) {
+      return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto previous = state.last_frame;
+    publish_(state, now);
+    // An unchanged payload is only repeated as a heartbeat.
+    Frame frame = state.last_frame;
+    if (state.config.skip_unchanged && state.last_frame == previous) {
+      frame = nullptr;
+    }
+
+    for (auto it = state.subscribers.begin(); it != state.subscribers.end();) {
+      std::erase_if(it->second, [&](Subscriber& sub) {
+        auto conn = sub.conn.lock();
+        if (!conn || conn->closed) {
+          ++removed;
+          return true;
+        }
+        if (should_reset_(sub, now)) {
+          end_stream_(*conn, sub.stream_id);
+          ++removed;
+          return true;
+        }
+        if (!frame) {
+          return false;
+        }
+        if (backpressured_(*conn)) {
+          if (state.config.backpressure == Backpressure::Coalesce) {
+            sub.pending = frame;
+          }
+          return false;
+        }
+        sub.pending.reset();
+        deliver_(*conn, sub, *frame);
+        return false;
+      });
+      it = it->second.empty() ? state.subscribers.erase(it) : std::next(it);
+    }
+  }
+  released_(channel, removed);
+}
+
+} // namespace neonsignal
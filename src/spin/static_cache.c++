@@ -0,0 +1,11 @@
+#include "spin/static_cache.h++"
+
+#include <algorithm>
+
+namespace neonsignal {
+
+StaticFileCache::StaticFileCache(std::size_t max_cache_size_bytes, std::size_t max_entry_bytes)
+    : max_cache_size_bytes_(max_cache_size_bytes),
+      max_entry_bytes_(std::min(max_entry_bytes, max_cache_size_bytes)) {}
+
+} // namespace neonsignal
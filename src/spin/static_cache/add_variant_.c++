@@ -0,0 +1,35 @@
+#include "spin/static_cache.h++"
+
+namespace neonsignal {
+
+void StaticFileCache::add_variant_(const std::string& key,
+                                   const std::shared_ptr<const CachedFile>& identity,
+                                   std::shared_ptr<const CachedFile> variant) {
+  std::lock_guard lock(mutex_);
+  auto it = entries_.find(key);
+  // The file may have been invalidated or replaced while this was compressing.
+  if (it == entries_.end() ||
+      it->second.variants[static_cast<std::size_t>(ContentEncoding::identity)] != identity) {
+    return;
+  }
+  if (current_size_bytes_ + variant->memory_bytes() > max_cache_size_bytes_) {
+    return;
+  }
+
+  const auto index = static_cast<std::size_t>(variant->encoding);
+  auto& slot_variant = it->second.variants[index];
+  const bool new_source = !slot_variant || slot_variant->source != variant->source;
+  if (slot_variant) {
+    current_size_bytes_ -= slot_variant->memory_bytes();
+    variant_bytes_[index] -= slot_variant->memory_bytes();
+  }
+  if (new_source && variant->source != identity->source) {
+    // Sibling file: changes to it must invalidate this key too.
+    keys_by_source_.emplace(variant->source.string(), key);
+  }
+  current_size_bytes_ += variant->memory_bytes();
+  variant_bytes_[index] += variant->memory_bytes();
+  slot_variant = std::move(variant);
+}
+
+} // namespace neonsignal
@@ -0,0 +1,67 @@
+#include "spin/static_cache.h++"
+
+#include <fstream>
+#include <iterator>
+
+namespace neonsignal {
+
+namespace {
+
+constexpr ContentEncoding kVariants[] = {ContentEncoding::br, ContentEncoding::zstd,
+                                         ContentEncoding::gzip};
+
+// Bodies this small gain less from compression than the headers cost.
+constexpr std::size_t kMinCompressBytes = 256;
+
+} // namespace
+
+void StaticFileCache::build_variants_(const std::string& key,
+                                      const std::shared_ptr<const CachedFile>& identity,
+                                      const std::vector<std::uint8_t>& content) {
+  if (!identity->vary) {
+    return;
+  }
+
+  // Deploy-provided siblings (app.js.br, app.js.gz, app.js.zst) win over
+  // anything built here. Both are disk or CPU work, so neither runs on the
+  // event loop; the entry serves identity until the variants land.
+  auto build = [this, key, identity, content]() {
+    for (auto encoding : kVariants) {
+      auto sibling = identity->source;
+      sibling += std::string(content_encoding_suffix(encoding));
+
+      std::error_code ec;
+      if (std::filesystem::is_regular_file(sibling, ec) &&
+          std::filesystem::file_size(sibling, ec) <= max_entry_bytes_ && !ec) {
+        std::ifstream in(sibling, std::ios::binary);
+        std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(in)),
+                                        std::istreambuf_iterator<char>());
+        if (in.good() || in.eof()) {
+          add_variant_(key, identity,
+                       CachedFile::make(sibling, identity->mime_type, bytes, encoding, true));
+          continue;
+        }
+      }
+      if (!can_compress(encoding) || content.size() < kMinCompressBytes) {
+        continue;
+      }
+
+      auto compressed = compress_content(encoding, content);
+      // Only keep variants that actually save bandwidth (at least ~5%).
+      if (!compressed || compressed->size() * 20 > content.size() * 19) {
+        continue;
+      }
+      add_variant_(key, identity,
+                   CachedFile::make(identity->source, identity->mime_type, *compressed, encoding,
+                                    true));
+    }
+  };
+
+  if (executor_) {
+    executor_(std::move(build));
+  } else {
+    build();
+  }
+}
+
+} // namespace neonsignal
@@ -0,0 +1,180 @@
+#include "spin/static_cache.h++"
+
+#include "spin/http2_listener_helpers.h++"
+
+#include <openssl/evp.h>
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace neonsignal {
+
+namespace {
+
+void patch_stream_id(std::uint8_t *frame_header, std::uint32_t stream_id) {
+  frame_header[5] = static_cast<std::uint8_t>((stream_id >> 24) & 0x7F);
+  frame_header[6] = static_cast<std::uint8_t>((stream_id >> 16) & 0xFF);
+  frame_header[7] = static_cast<std::uint8_t>((stream_id >> 8) & 0xFF);
+  frame_header[8] = static_cast<std::uint8_t>(stream_id & 0xFF);
+}
+
+std::string content_etag(const std::vector<std::uint8_t> &content) {
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_len = 0;
+  if (EVP_Digest(content.data(), content.size(), digest, &digest_len, EVP_sha256(), nullptr) !=
+      1) {
+    digest_len = 0;
+  }
+
+  // 128 bits of SHA-256 is plenty for a validator and keeps the header short.
+  std::string etag = "\"";
+  for (unsigned int i = 0; i < std::min(digest_len, 16U); ++i) {
+    etag += std::format("{:02x}", digest[i]);
+  }
+  etag += '"';
+  return etag;
+}
+
+// content-encoding/vary describe the representation and go on 200 and 304 alike.
+void encode_representation(std::vector<std::uint8_t> &block, const CachedFile &file) {
+  if (file.encoding != ContentEncoding::identity) {
+    encode_literal_header_no_index(block, 26, content_encoding_token(file.encoding));
+  }
+  if (file.vary) {
+    encode_literal_header_no_index(block, 59, "accept-encoding"); // vary
+  }
+}
+
+void encode_validators(std::vector<std::uint8_t> &block, const CachedFile &file) {
+  encode_literal_header_no_index(block, 28, std::to_string(file.body_size)); // content-length
+  encode_literal_header_no_index(block, 34, file.etag);                      // etag
+}
+
+} // namespace
+
+std::shared_ptr<const CachedFile> CachedFile::make(std::filesystem::path source,
+                                                   std::string mime_type,
+                                                   const std::vector<std::uint8_t> &content,
+                                                   ContentEncoding encoding, bool vary) {
+  auto file = std::make_shared<CachedFile>();
+  file->source = std::move(source);
+  file->mime_type = std::move(mime_type);
+  file->etag = content_etag(content);
+  file->encoding = encoding;
+  file->vary = vary;
+  file->body_size = content.size();
+
+  // 200: HEADERS + DATA frames with a zero stream id, patched at send time.
+  std::vector<std::uint8_t> block;
+  encode_response_headers(block, 200, file->mime_type, {});
+  encode_representation(block, *file);
+  encode_validators(block, *file);
+  file->frames.reserve(9 + block.size() + content.size() + 9 * (content.size() / 16384 + 1));
+  append_frame_header(file->frames, static_cast<std::uint32_t>(block.size()), 0x1 /* HEADERS */,
+                      0x4 /* END_HEADERS */, 0);
+  file->frames.insert(file->frames.end(), block.begin(), block.end());
+  append_data_frames(file->frames, 0, content);
+
+  for (std::size_t off = 0; off + 9 <= file->frames.size();) {
+    file->frame_offsets.push_back(off);
+    const std::size_t len = (static_cast<std::size_t>(file->frames[off]) << 16) |
+                            (static_cast<std::size_t>(file->frames[off + 1]) << 8) |
+                            static_cast<std::size_t>(file->frames[off + 2]);
+    off += 9 + len;
+  }
+
+  // 304: a single HEADERS frame that also ends the stream.
+  std::vector<std::uint8_t> nm_block;
+  encode_response_headers(nm_block, 304, {}, {});
+  encode_representation(nm_block, *file);
+  encode_literal_header_no_index(nm_block, 34, file->etag);
+  append_frame_header(file->not_modified, static_cast<std::uint32_t>(nm_block.size()),
+                      0x1 /* HEADERS */, 0x4 | 0x1 /* END_HEADERS | END_STREAM */, 0);
+  file->not_modified.insert(file->not_modified.end(), nm_block.begin(), nm_block.end());
+
+  return file;
+}
+
+void CachedFile::append_headers(
+    std::vector<std::uint8_t> &out, std::uint32_t stream_id,
+    const std::vector<std::pair<std::string, std::string>> &extra_headers) const {
+  if (extra_headers.empty()) {
+    const std::size_t headers_end = frame_offsets.size() > 1 ? frame_offsets[1] : frames.size();
+    const std::size_t base = out.size();
+    out.insert(out.end(), frames.begin(), frames.begin() + static_cast<long>(headers_end));
+    patch_stream_id(out.data() + base, stream_id);
+    return;
+  }
+
+  std::vector<std::uint8_t> block;
+  encode_response_headers(block, 200, mime_type, extra_headers);
+  encode_representation(block, *this);
+  encode_validators(block, *this);
+  append_frame_header(out, static_cast<std::uint32_t>(block.size()), 0x1 /* HEADERS */,
+                      0x4 /* END_HEADERS */, stream_id);
+  out.insert(out.end(), block.begin(), block.end());
+}
+
+void CachedFile::queue_body(OutboundFlow &flow, std::uint32_t stream_id) const {
+  // DATA payloads go out as slices of `frames`; the aliasing pointer keeps
+  // this entry alive until the last slice has been written.
+  WriteQueue::Buffer buffer(shared_from_this(), &frames);
+  for (std::size_t i = 1; i < frame_offsets.size(); ++i) {
+    const std::size_t off = frame_offsets[i];
+    const std::size_t len = (static_cast<std::size_t>(frames[off]) << 16) |
+                            (static_cast<std::size_t>(frames[off + 1]) << 8) |
+                            static_cast<std::size_t>(frames[off + 2]);
+    flow.push_data(stream_id, buffer, off + 9, len, (frames[off + 4] & 0x1) != 0);
+  }
+}
+
+void CachedFile::append_not_modified(std::vector<std::uint8_t> &out,
+                                     std::uint32_t stream_id) const {
+  const std::size_t base = out.size();
+  out.insert(out.end(), not_modified.begin(), not_modified.end());
+  patch_stream_id(out.data() + base, stream_id);
+}
+
+bool CachedFile::matches_etag(std::string_view if_none_match) const {
+  std::string_view strong(etag);
+  while (!if_none_match.empty()) {
+    auto comma = if_none_match.find(',');
+    auto candidate = if_none_match.substr(0, comma);
+    if_none_match = comma == std::string_view::npos ? std::string_view{}
+                                                    : if_none_match.substr(comma + 1);
+
+    while (!candidate.empty() && (candidate.front() == ' ' || candidate.front() == '\t')) {
+      candidate.remove_prefix(1);
+    }
+    while (!candidate.empty() && (candidate.back() == ' ' || candidate.back() == '\t')) {
+      candidate.remove_suffix(1);
+    }
+    if (candidate == "*") {
+      return true;
+    }
+    if (candidate.starts_with("W/")) {
+      candidate.remove_prefix(2);
+    }
+    if (candidate == strong) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<std::uint8_t> CachedFile::body() const {
+  std::vector<std::uint8_t> out;
+  out.reserve(body_size);
+  for (std::size_t i = 1; i < frame_offsets.size(); ++i) {
+    const std::size_t off = frame_offsets[i];
+    const std::size_t end = i + 1 < frame_offsets.size() ? frame_offsets[i + 1] : frames.size();
+    out.insert(out.end(), frames.begin() + static_cast<long>(off + 9),
+               frames.begin() + static_cast<long>(end));
+  }
+  return out;
+}
+
+} // namespace neonsignal
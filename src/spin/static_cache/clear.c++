@@ -0,0 +1,14 @@
+#include "spin/static_cache.h++"
+
+namespace neonsignal {
+
+void StaticFileCache::clear() {
+  std::lock_guard lock(mutex_);
+  entries_.clear();
+  lru_.clear();
+  keys_by_source_.clear();
+  current_size_bytes_ = 0;
+  variant_bytes_.fill(0);
+}
+
+} // namespace neonsignal
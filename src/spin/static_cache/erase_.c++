@@ -0,0 +1,30 @@
+#include "spin/static_cache.h++"
+
+#include <iterator>
+
+namespace neonsignal {
+
+void StaticFileCache::erase_(std::unordered_map<std::string, Slot>::iterator it) {
+  std::unordered_set<std::string> sources;
+  for (std::size_t i = 0; i < kContentEncodingCount; ++i) {
+    const auto& variant = it->second.variants[i];
+    if (!variant) {
+      continue;
+    }
+    sources.insert(variant->source.string());
+    current_size_bytes_ -= variant->memory_bytes();
+    variant_bytes_[i] -= variant->memory_bytes();
+  }
+
+  for (const auto& source : sources) {
+    auto [first, last] = keys_by_source_.equal_range(source);
+    for (auto key_it = first; key_it != last;) {
+      key_it = key_it->second == it->first ? keys_by_source_.erase(key_it) : std::next(key_it);
+    }
+  }
+
+  lru_.erase(it->second.lru_it);
+  entries_.erase(it);
+}
+
+} // namespace neonsignal
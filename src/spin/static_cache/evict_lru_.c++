@@ -0,0 +1,17 @@
+#include "spin/static_cache.h++"
+
+namespace neonsignal {
+
+void StaticFileCache::evict_lru_() {
+  if (lru_.empty()) {
+    return;
+  }
+  // The back of the list is the least recently used key.
+  if (auto it = entries_.find(lru_.back()); it != entries_.end()) {
+    erase_(it);
+  } else {
+    lru_.pop_back();
+  }
+}
+
+} // namespace neonsignal
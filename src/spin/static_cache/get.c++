@@ -0,0 +1,28 @@
+#include "spin/static_cache.h++"
+
+namespace neonsignal {
+
+std::shared_ptr<const CachedFile> StaticFileCache::get(std::string_view path,
+                                                       EncodingMask accepted) {
+  // Smallest output first; identity is always acceptable.
+  static constexpr ContentEncoding kPreference[] = {ContentEncoding::br, ContentEncoding::zstd,
+                                                    ContentEncoding::gzip};
+
+  std::lock_guard lock(mutex_);
+  auto it = entries_.find(std::string(path));
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+
+  const auto& variants = it->second.variants;
+  for (auto encoding : kPreference) {
+    const auto& variant = variants[static_cast<std::size_t>(encoding)];
+    if (variant && (accepted & encoding_bit(encoding))) {
+      return variant;
+    }
+  }
+  return variants[static_cast<std::size_t>(ContentEncoding::identity)];
+}
+
+} // namespace neonsignal
@@ -0,0 +1,20 @@
+#include "spin/static_cache.h++"
+
+namespace neonsignal {
+
+void StaticFileCache::invalidate_directory(const std::filesystem::path& directory) {
+  auto prefix = (directory.lexically_normal() / "").string();
+  std::lock_guard lock(mutex_);
+  // Whole-directory events (rename/delete of the directory itself) are rare,
+  // so a linear scan is fine here.
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    auto next = std::next(it);
+    const auto& identity = it->second.variants[static_cast<std::size_t>(ContentEncoding::identity)];
+    if (identity->source.string().starts_with(prefix)) {
+      erase_(it);
+    }
+    it = next;
+  }
+}
+
+} // namespace neonsignal
@@ -0,0 +1,19 @@
+#include "spin/static_cache.h++"
+
+namespace neonsignal {
+
+void StaticFileCache::invalidate_file(const std::filesystem::path& source) {
+  std::lock_guard lock(mutex_);
+  auto [first, last] = keys_by_source_.equal_range(source.lexically_normal().string());
+  std::vector<std::string> keys;
+  for (auto it = first; it != last; ++it) {
+    keys.push_back(it->second);
+  }
+  for (const auto& key : keys) {
+    if (auto it = entries_.find(key); it != entries_.end()) {
+      erase_(it);
+    }
+  }
+}
+
+} // namespace neonsignal
@@ -0,0 +1,33 @@
+#include "spin/static_cache.h++"
+
+#include "spin/http2_listener_helpers.h++"
+
+#include <format>
+#include <fstream>
+#include <iostream>
+
+namespace neonsignal {
+
+void StaticFileCache::load_file_(const std::filesystem::path& file_path,
+                                 const std::string& cache_key) {
+  try {
+    watch(file_path);
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file) return;
+
+    // Read entire file
+    file.seekg(0, std::ios::end);
+    auto size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    std::vector<std::uint8_t> content(static_cast<std::size_t>(size));
+    file.read(reinterpret_cast<char*>(content.data()), size);
+
+    put(cache_key, file_path, content, guess_content_type(file_path));
+
+  } catch (const std::exception& e) {
+    std::cerr << std::format("✗ Failed to load {}: {}\n", file_path.string(), e.what());
+  }
+}
+
+} // namespace neonsignal
@@ -0,0 +1,53 @@
+#include "spin/static_cache.h++"
+
+#include <format>
+#include <iostream>
+
+namespace neonsignal {
+
+namespace {
+
+bool is_precompressed_sibling(const std::filesystem::path& path) {
+  for (auto encoding : {ContentEncoding::br, ContentEncoding::gzip, ContentEncoding::zstd}) {
+    if (path.extension() == content_encoding_suffix(encoding)) {
+      auto original = path;
+      original.replace_extension();
+      return std::filesystem::exists(original);
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+void StaticFileCache::preload(const std::filesystem::path& public_root) {
+  // Critical files that should ALWAYS be in memory
+  const std::vector<std::string> critical_files = {
+      "index.html",
+      "app.js",
+      "app.css",
+      "favicon.ico"
+  };
+
+  for (const auto& file : critical_files) {
+    auto path = public_root / file;
+    if (std::filesystem::exists(path)) {
+      load_file_(path, "/" + file);
+    }
+  }
+
+  // Scan and pre-load small files (< 100KB)
+  for (const auto& entry : std::filesystem::recursive_directory_iterator(public_root)) {
+    if (is_precompressed_sibling(entry.path())) {
+      continue; // attached to its original as a variant
+    }
+    if (entry.is_regular_file() && entry.file_size() < 100 * 1024) {
+      auto rel_path = std::filesystem::relative(entry.path(), public_root);
+      load_file_(entry.path(), "/" + rel_path.string());
+    }
+  }
+
+  std::cerr << std::format("• Static cache: {} files loaded, {} bytes\n", size(), bytes());
+}
+
+} // namespace neonsignal
@@ -0,0 +1,45 @@
+#include "spin/static_cache.h++"
+
+namespace neonsignal {
+
+std::shared_ptr<const CachedFile>
+StaticFileCache::put(std::string_view path, const std::filesystem::path& source,
+                     const std::vector<std::uint8_t>& content, std::string mime_type) {
+  if (content.size() > max_entry_bytes_) {
+    return nullptr;
+  }
+
+  // Hashing and framing happen outside the lock.
+  auto normalized = source.lexically_normal();
+  const bool compressible = is_compressible_mime(mime_type);
+  auto file = CachedFile::make(normalized, std::move(mime_type), content,
+                               ContentEncoding::identity, compressible);
+  const std::string key(path);
+  {
+    std::lock_guard lock(mutex_);
+
+    if (auto existing = entries_.find(key); existing != entries_.end()) {
+      erase_(existing);
+    }
+
+    // Evict if over size limit
+    while (current_size_bytes_ + file->memory_bytes() > max_cache_size_bytes_ &&
+           !entries_.empty()) {
+      evict_lru_();
+    }
+
+    lru_.push_front(key);
+    Slot slot;
+    slot.variants[static_cast<std::size_t>(ContentEncoding::identity)] = file;
+    slot.lru_it = lru_.begin();
+    entries_.emplace(key, std::move(slot));
+    keys_by_source_.emplace(normalized.string(), key);
+    current_size_bytes_ += file->memory_bytes();
+    variant_bytes_[static_cast<std::size_t>(ContentEncoding::identity)] += file->memory_bytes();
+  }
+
+  build_variants_(key, file, content);
+  return file;
+}
+
+} // namespace neonsignal
@@ -0,0 +1,155 @@
+#include "spin/static_cache.h++"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+namespace neonsignal {
+
+StaticCacheRegistry::StaticCacheRegistry() {
+#ifdef __linux__
+  watch_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (watch_fd_ < 0) {
+    std::cerr << "▲ Static cache: inotify unavailable (" << std::strerror(errno)
+              << "), file changes need a restart\n";
+  }
+#else
+  std::cerr << "▲ Static cache: change notifications not supported on this platform, "
+               "file changes need a restart\n";
+#endif
+}
+
+StaticCacheRegistry::~StaticCacheRegistry() {
+  if (watch_fd_ >= 0) {
+    close(watch_fd_);
+  }
+}
+
+StaticFileCache& StaticCacheRegistry::for_root(const std::filesystem::path& document_root) {
+  std::lock_guard lock(mutex_);
+  auto key = document_root.lexically_normal().string();
+  auto it = caches_by_root_.find(key);
+  if (it == caches_by_root_.end()) {
+    auto cache = std::make_unique<StaticFileCache>();
+    cache->set_watch_hook(
+        [this](const std::filesystem::path& directory) { watch_directory_(directory); });
+    cache->set_executor(executor_);
+    it = caches_by_root_.emplace(std::move(key), std::move(cache)).first;
+  }
+  return *it->second;
+}
+
+void StaticCacheRegistry::set_executor(StaticFileCache::Executor executor) {
+  std::lock_guard lock(mutex_);
+  executor_ = std::move(executor);
+  for (auto& [root, cache] : caches_by_root_) {
+    cache->set_executor(executor_);
+  }
+}
+
+std::vector<StaticFileCache*> StaticCacheRegistry::caches_() const {
+  std::lock_guard lock(mutex_);
+  std::vector<StaticFileCache*> caches;
+  caches.reserve(caches_by_root_.size());
+  for (const auto& [root, cache] : caches_by_root_) {
+    caches.push_back(cache.get());
+  }
+  return caches;
+}
+
+void StaticCacheRegistry::watch_directory_(const std::filesystem::path& directory) {
+#ifdef __linux__
+  if (watch_fd_ < 0) {
+    return;
+  }
+  std::lock_guard lock(mutex_);
+  auto key = directory.string();
+  if (watched_paths_.contains(key)) {
+    return;
+  }
+  const auto dir = key.empty() ? std::string(".") : key;
+  int wd = inotify_add_watch(watch_fd_, dir.c_str(),
+                             IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE |
+                                 IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+  if (wd < 0) {
+    std::cerr << "▲ Static cache: cannot watch " << dir << ": " << std::strerror(errno) << '\n';
+    return;
+  }
+  watched_dirs_[wd] = directory;
+  watched_paths_.insert(std::move(key));
+#else
+  (void)directory;
+#endif
+}
+
+void StaticCacheRegistry::process_events() {
+#ifdef __linux__
+  if (watch_fd_ < 0) {
+    return;
+  }
+
+  alignas(inotify_event) char buf[4096];
+  for (;;) {
+    ssize_t n = read(watch_fd_, buf, sizeof(buf));
+    if (n <= 0) {
+      break;
+    }
+
+    for (char* p = buf; p < buf + n;) {
+      auto* ev = reinterpret_cast<inotify_event*>(p);
+      p += sizeof(inotify_event) + ev->len;
+
+      if (ev->mask & IN_Q_OVERFLOW) {
+        // Lost events: nothing cached can be trusted anymore.
+        std::cerr << "▲ Static cache: change queue overflow, clearing caches\n";
+        for (auto* cache : caches_()) {
+          cache->clear();
+        }
+        continue;
+      }
+
+      std::filesystem::path directory;
+      {
+        std::lock_guard lock(mutex_);
+        auto it = watched_dirs_.find(ev->wd);
+        if (it == watched_dirs_.end()) {
+          continue;
+        }
+        directory = it->second;
+        if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+          // The path no longer names the watched inode (e.g. a deploy swapped
+          // the directory). Forget it; it is re-armed when a file is cached again.
+          if (ev->mask & IN_MOVE_SELF) {
+            inotify_rm_watch(watch_fd_, ev->wd);
+          }
+          watched_paths_.erase(directory.string());
+          watched_dirs_.erase(it);
+        }
+      }
+
+      if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+        for (auto* cache : caches_()) {
+          cache->invalidate_directory(directory);
+        }
+      } else if (ev->len > 0) {
+        auto changed = directory / ev->name;
+        for (auto* cache : caches_()) {
+          cache->invalidate_file(changed);
+          if (ev->mask & (IN_MOVED_FROM | IN_DELETE)) {
+            // A whole subdirectory may have been swapped out.
+            cache->invalidate_directory(changed);
+          }
+        }
+      }
+    }
+  }
+#endif
+}
+
+} // namespace neonsignal
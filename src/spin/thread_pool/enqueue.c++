@@ -1,5 +1,7 @@
 #include "spin/thread_pool.h++"
 
+#include "spin/metrics.h++"
+
 #include <stdexcept>
 #include <utility>
 
@@ -11,7 +13,10 @@ void ThreadPool::enqueue(std::function<void()> task) {
     if (stop_) {
       throw std::runtime_error("cannot enqueue on stopped ThreadPool");
     }
-    tasks_.push(std::move(task));
+    tasks_.push({std::move(task), std::chrono::steady_clock::now()});
+    if (queue_depth_) {
+      queue_depth_->set(static_cast<std::int64_t>(tasks_.size()));
+    }
   }
   cv_.notify_one();
 }
@@ -0,0 +1,11 @@
+#include "spin/thread_pool.h++"
+
+namespace neonsignal {
+
+void ThreadPool::set_metrics(Gauge* queue_depth, Histogram* task_wait) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  queue_depth_ = queue_depth;
+  task_wait_ = task_wait;
+}
+
+} // namespace neonsignal
@@ -1,12 +1,15 @@
 #include "spin/thread_pool.h++"
 
+#include "spin/metrics.h++"
+
 #include <utility>
 
 namespace neonsignal {
 
 void ThreadPool::worker_() {
   for (;;) {
-    std::function<void()> task;
+    Task task;
+    Histogram* task_wait = nullptr;
     {
       std::unique_lock<std::mutex> lock(mutex_);
       cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
@@ -15,8 +18,15 @@ void ThreadPool::worker_() {
       }
       task = std::move(tasks_.front());
       tasks_.pop();
+      if (queue_depth_) {
+        queue_depth_->set(static_cast<std::int64_t>(tasks_.size()));
+      }
+      task_wait = task_wait_;
+    }
+    if (task_wait) {
+      task_wait->record(std::chrono::steady_clock::now() - task.enqueued);
     }
-    task();
+    task.fn();
   }
 }
 
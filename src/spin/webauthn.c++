@@ -18,6 +18,7 @@
 #include <chrono>
 #include <cstring>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string_view>
 #include <variant>
@@ -263,7 +264,7 @@ WebAuthnManager::WebAuthnManager(std::string rp_id, std::string origin, Database
 }
 
 bool WebAuthnManager::load_credentials() {
-  credentials_.clear();
+  std::vector<WebAuthnCredential> loaded;
   auto users = db_.list_users();
   for (const auto& user : users) {
     // Skip users without credentials (pending enrollment)
@@ -277,9 +278,11 @@ bool WebAuthnManager::load_credentials() {
     cred.credential_id = user.credential_id;
     cred.public_key_spki = user.public_key;
     cred.sign_count = user.sign_count;
-    credentials_.push_back(std::move(cred));
+    loaded.push_back(std::move(cred));
   }
-  std::cerr << "• webauthn: loaded " << credentials_.size() << " credential(s)\n";
+  std::cerr << "• webauthn: loaded " << loaded.size() << " credential(s)\n";
+  std::lock_guard lock(mutex_);
+  credentials_ = std::move(loaded);
   return true;
 }
 
@@ -290,6 +293,7 @@ WebAuthnLoginOptions WebAuthnManager::make_login_options() {
   out.challenge = base64url_encode(challenge);
 
   Challenge c{out.challenge, std::chrono::steady_clock::now() + std::chrono::minutes(5)};
+  std::lock_guard lock(mutex_);
   challenges_[out.challenge] = c;
 
   std::ostringstream opts;
@@ -310,6 +314,7 @@ WebAuthnLoginOptions WebAuthnManager::make_login_options() {
 
 std::optional<WebAuthnCredential>
 WebAuthnManager::find_credential(const std::vector<std::uint8_t> &credential_id) const {
+  std::lock_guard lock(mutex_);
   for (const auto &cred : credentials_) {
     if (cred.credential_id == credential_id) {
       return cred;
@@ -400,20 +405,9 @@ WebAuthnLoginResult WebAuthnManager::finish_login(std::string_view body) {
   }
   auto chal_bytes = base64url_decode(challenge_str);
   auto chal_canon = chal_bytes.empty() ? challenge_str : base64url_encode(chal_bytes);
-  auto ch_it = challenges_.find(challenge_str);
-  if (ch_it == challenges_.end() && !chal_canon.empty()) {
-    ch_it = challenges_.find(chal_canon);
-  }
-  if (ch_it == challenges_.end()) {
-    res.error = "unknown challenge";
-    return res;
-  }
-  if (ch_it->second.expires_at < std::chrono::steady_clock::now()) {
-    challenges_.erase(ch_it);
-    res.error = "challenge expired";
+  if (!consume_challenge_(challenge_str, chal_canon, res.error)) {
     return res;
   }
-  challenges_.erase(ch_it);
 
   std::string origin = extract_json_string(client_data_json, "origin");
   if (origin != origin_) {
@@ -452,6 +446,7 @@ WebAuthnLoginResult WebAuthnManager::finish_login(std::string_view body) {
   res.user = cred->user;
   res.session_id = issue_session(cred->user_id, cred->user, "auth");
   // Update sign count and persist.
+  std::lock_guard lock(mutex_);
   for (auto &c : credentials_) {
     if (c.credential_id == credential_id) {
       c.sign_count = sign_count;
@@ -489,7 +484,10 @@ WebAuthnRegisterOptions WebAuthnManager::make_register_options_for_user(std::uin
   out.challenge = base64url_encode(challenge);
 
   Challenge c{out.challenge, std::chrono::steady_clock::now() + std::chrono::minutes(5)};
-  challenges_[out.challenge] = c;
+  {
+    std::lock_guard lock(mutex_);
+    challenges_[out.challenge] = c;
+  }
 
   // Use numeric user_id as the WebAuthn user handle
   std::vector<std::uint8_t> user_handle(8);
@@ -670,20 +668,9 @@ WebAuthnRegisterResult WebAuthnManager::finish_register_for_user(std::string_vie
   }
   auto chal_bytes = base64url_decode(challenge_str);
   auto chal_canon = chal_bytes.empty() ? challenge_str : base64url_encode(chal_bytes);
-  auto ch_it = challenges_.find(challenge_str);
-  if (ch_it == challenges_.end() && !chal_canon.empty()) {
-    ch_it = challenges_.find(chal_canon);
-  }
-  if (ch_it == challenges_.end()) {
-    res.error = "unknown challenge";
-    return res;
-  }
-  if (ch_it->second.expires_at < std::chrono::steady_clock::now()) {
-    challenges_.erase(ch_it);
-    res.error = "challenge expired";
+  if (!consume_challenge_(challenge_str, chal_canon, res.error)) {
     return res;
   }
-  challenges_.erase(ch_it);
   if (origin != origin_) {
     res.error = "origin mismatch";
     return res;
@@ -739,12 +726,35 @@ WebAuthnRegisterResult WebAuthnManager::finish_register_for_user(std::string_vie
   cred.credential_id = cred_id;
   cred.public_key_spki = *spki;
   cred.sign_count = 0;
-  credentials_.push_back(std::move(cred));
+  {
+    std::lock_guard lock(mutex_);
+    credentials_.push_back(std::move(cred));
+  }
 
   res.ok = true;
   return res;
 }
 
+bool WebAuthnManager::consume_challenge_(const std::string &challenge,
+                                         const std::string &canonical, std::string &error) {
+  std::lock_guard lock(mutex_);
+  auto ch_it = challenges_.find(challenge);
+  if (ch_it == challenges_.end() && !canonical.empty()) {
+    ch_it = challenges_.find(canonical);
+  }
+  if (ch_it == challenges_.end()) {
+    error = "unknown challenge";
+    return false;
+  }
+  if (ch_it->second.expires_at < std::chrono::steady_clock::now()) {
+    challenges_.erase(ch_it);
+    error = "challenge expired";
+    return false;
+  }
+  challenges_.erase(ch_it);
+  return true;
+}
+
 bool WebAuthnManager::user_exists(std::string_view user) {
   return db_.find_user_by_email(user).has_value();
 }
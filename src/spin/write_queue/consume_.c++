@@ -0,0 +1,21 @@
+#include "spin/write_queue.h++"
+
+#include <algorithm>
+
+namespace neonsignal {
+
+void WriteQueue::consume_(std::size_t n) {
+  bytes_ -= std::min(n, bytes_);
+  while (n > 0 && !segments_.empty()) {
+    auto left = segments_.front().size() - front_sent_;
+    if (n < left) {
+      front_sent_ += n;
+      return;
+    }
+    n -= left;
+    front_sent_ = 0;
+    segments_.pop_front();
+  }
+}
+
+} // namespace neonsignal
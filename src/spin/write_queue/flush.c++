@@ -0,0 +1,82 @@
+#include "spin/write_queue.h++"
+
+#include <algorithm>
+#include <climits>
+
+namespace neonsignal {
+
+WriteQueue::FlushResult WriteQueue::flush(SSL* ssl, int& ssl_error) {
+  while (!segments_.empty()) {
+    const auto& front = segments_.front();
+    const std::uint8_t* out = nullptr;
+    std::size_t len = 0;
+
+    if (front.file && front_sent_ >= front.header_len) {
+      // File payload: the kernel reads the page cache and encrypts in place.
+      auto skip = front_sent_ - front.header_len;
+      auto n = SSL_sendfile(ssl, front.file->fd, static_cast<off_t>(front.file_offset + skip),
+                            front.length - skip, 0);
+      if (n > 0) {
+        consume_(static_cast<std::size_t>(n));
+        continue;
+      }
+      ssl_error = SSL_get_error(ssl, static_cast<int>(n));
+      if (ssl_error == SSL_ERROR_WANT_WRITE || ssl_error == SSL_ERROR_WANT_READ) {
+        return FlushResult::WouldBlock;
+      }
+      return FlushResult::Error;
+    }
+
+    if (front_sent_ >= front.header_len && front.size() - front_sent_ >= kCoalesceBytes) {
+      // Large slice: hand it to OpenSSL without copying.
+      auto skip = front_sent_ - front.header_len;
+      out = front.buffer->data() + front.offset + skip;
+      len = front.length - skip;
+    } else {
+      // Gather small segments into one write. After a WouldBlock the queue
+      // head is unchanged, so the retry starts with the same bytes.
+      scratch_.clear();
+      auto skip = front_sent_;
+      for (const auto& segment : segments_) {
+        if (scratch_.size() >= kCoalesceBytes) {
+          break;
+        }
+        auto room = kCoalesceBytes - scratch_.size();
+        if (skip < segment.header_len) {
+          auto take = std::min<std::size_t>(segment.header_len - skip, room);
+          scratch_.insert(scratch_.end(), segment.header.begin() + skip,
+                          segment.header.begin() + skip + take);
+          room -= take;
+          skip = 0;
+        } else {
+          skip -= segment.header_len;
+        }
+        if (segment.file) {
+          break; // the payload goes out with SSL_sendfile() once this is written
+        }
+        auto take = std::min(segment.length - skip, room);
+        if (take > 0) {
+          const auto* data = segment.buffer->data() + segment.offset + skip;
+          scratch_.insert(scratch_.end(), data, data + take);
+        }
+        skip = 0;
+      }
+      out = scratch_.data();
+      len = scratch_.size();
+    }
+
+    int n = SSL_write(ssl, out, static_cast<int>(std::min<std::size_t>(len, INT_MAX)));
+    if (n > 0) {
+      consume_(static_cast<std::size_t>(n));
+      continue;
+    }
+    ssl_error = SSL_get_error(ssl, n);
+    if (ssl_error == SSL_ERROR_WANT_WRITE || ssl_error == SSL_ERROR_WANT_READ) {
+      return FlushResult::WouldBlock;
+    }
+    return FlushResult::Error;
+  }
+  return FlushResult::Drained;
+}
+
+} // namespace neonsignal
@@ -0,0 +1,37 @@
+#include "spin/write_queue.h++"
+
+namespace neonsignal {
+
+void WriteQueue::push(std::vector<std::uint8_t>&& bytes) {
+  if (bytes.empty()) {
+    return;
+  }
+  auto length = bytes.size();
+  push(std::make_shared<const std::vector<std::uint8_t>>(std::move(bytes)), 0, length);
+}
+
+void WriteQueue::push(Buffer buffer, std::size_t offset, std::size_t length) {
+  if (length == 0) {
+    return;
+  }
+  Segment segment;
+  segment.buffer = std::move(buffer);
+  segment.offset = offset;
+  segment.length = length;
+  bytes_ += length;
+  segments_.push_back(std::move(segment));
+}
+
+void WriteQueue::push_frame(const FrameHeader& header, Buffer buffer, std::size_t offset,
+                            std::size_t length) {
+  Segment segment;
+  segment.header = header;
+  segment.header_len = static_cast<std::uint8_t>(header.size());
+  segment.buffer = std::move(buffer);
+  segment.offset = offset;
+  segment.length = length;
+  bytes_ += segment.size();
+  segments_.push_back(std::move(segment));
+}
+
+} // namespace neonsignal
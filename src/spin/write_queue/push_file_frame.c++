@@ -0,0 +1,25 @@
+#include "spin/write_queue.h++"
+
+#include <unistd.h>
+
+namespace neonsignal {
+
+WriteQueue::File::~File() {
+  if (fd >= 0) {
+    ::close(fd);
+  }
+}
+
+void WriteQueue::push_file_frame(const FrameHeader& header, FileRef file, std::uint64_t offset,
+                                 std::size_t length) {
+  Segment segment;
+  segment.header = header;
+  segment.header_len = static_cast<std::uint8_t>(header.size());
+  segment.length = length;
+  segment.file = std::move(file);
+  segment.file_offset = offset;
+  bytes_ += segment.size();
+  segments_.push_back(std::move(segment));
+}
+
+} // namespace neonsignal